@@ -1,8 +1,47 @@
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <wsjcpp_sql_builder.h>
 
+int generateQueries(const std::string &specFile, const std::string &outputFile, const std::string &namespaceName) {
+    std::ifstream spec(specFile);
+    if (!spec) {
+        std::cerr << "Could not read file " << specFile << std::endl;
+        return -1;
+    }
+    std::stringstream content;
+    content << spec.rdbuf();
+
+    if (!wsjcpp::SqlCodeGenerator::isIdentifier(namespaceName)) {
+        std::cerr << "Invalid namespace name '" << namespaceName << "'" << std::endl;
+        return -1;
+    }
+
+    wsjcpp::SqlCodeGenerator generator;
+    if (!generator.parseSpec(content.str())) {
+        for (auto err : generator.errors()) {
+            std::cerr << specFile << ": " << err << std::endl;
+        }
+        return -1;
+    }
+
+    std::ofstream output(outputFile);
+    output << generator.generateHeader(namespaceName, specFile);
+    if (!output) {
+        std::cerr << "Could not write file " << outputFile << std::endl;
+        return -1;
+    }
+    std::cout << "Generated " << generator.queries().size() << " queries to " << outputFile << std::endl;
+    return 0;
+}
+
 int main(int argc, const char* argv[]) {
 
+    if (argc >= 4 && std::string(argv[1]) == "generate-queries") {
+        // wsjcpp-sql-builder generate-queries <spec.sql> <output.h> [namespace]
+        return generateQueries(argv[2], argv[3], argc >= 5 ? argv[4] : "queries");
+    }
+
     wsjcpp::SqlBuilder builder;
         builder.selectFrom("users")
         .colum("id")
@@ -17,4 +56,3 @@ int main(int argc, const char* argv[]) {
 
     return 0;
 }
-
@@ -0,0 +1,121 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+int main() {
+  wsjcpp::SqlBuilder builder;
+  builder.insertInto("logs").addColums({"msg", "level"}).row("a", 1);
+  builder.insertInto("logs").addColums({"msg", "level"}).row("b", 2);
+  builder.insertInto("logs").addColums({"msg", "level"}).val("c").val(3);
+  builder.insertInto("logs").addColums({"msg"}).row("d"); // other columns
+  builder.deleteFrom("sessions").where().equal("id", 10);
+  builder.deleteFrom("sessions").where().equal("id", 11);
+  builder.deleteFrom("sessions").where().equal("id", 10);
+  builder.deleteFrom("sessions").where().equal("user", 5); // other key
+  builder.update("users").set("name", "a").set("level", 1).where().equal("id", 1);
+  builder.update("users").set("level", 2).where().equal("id", 1);
+  builder.update("users").set("rating", 3).where().equal("id", 1);
+  builder.update("users").set("level", 2).where().equal("id", 2); // other where
+
+  std::size_t removed = builder.coalesce();
+  if (removed != 6) {
+    std::cerr << "Expected 6 removed queries, but got " << removed << std::endl;
+    return -1;
+  }
+  if (checkStatements(builder.statements(), {
+    "INSERT INTO logs(msg, level) VALUES('a', 1), ('b', 2), ('c', 3)",
+    "INSERT INTO logs(msg) VALUES('d')",
+    "DELETE FROM sessions WHERE id IN (10, 11)",
+    "DELETE FROM sessions WHERE user = 5",
+    "UPDATE users SET name = 'a', level = 2, rating = 3 WHERE id = 1",
+    "UPDATE users SET level = 2 WHERE id = 2",
+  }) != 0) {
+    return -1;
+  }
+
+  // the second pass has nothing to do
+  if (builder.coalesce() != 0) {
+    std::cerr << "Expected nothing to coalesce" << std::endl;
+    return -1;
+  }
+
+  // update changes column from where, so the next update finds other rows
+  wsjcpp::SqlBuilder builder2;
+  builder2.update("users").set("status", 2).where().equal("status", 1);
+  builder2.update("users").set("level", 0).where().equal("status", 1);
+  // not neighbours
+  builder2.deleteFrom("sessions").where().equal("id", 1);
+  builder2.insertInto("sessions").addColums({"id"}).row(1);
+  builder2.deleteFrom("sessions").where().equal("id", 1);
+  if (builder2.coalesce() != 0) {
+    std::cerr << "Expected nothing to coalesce" << std::endl;
+    return -1;
+  }
+
+  // columns read by the subquery are changed by the first update
+  wsjcpp::SqlBuilder builder3;
+  wsjcpp::SqlSelect &pending1 = builder3.subSelect("t").colum("id");
+  pending1.where().equal("status", 1);
+  builder3.update("t").set("status", 2).where().inSelect("id", pending1);
+  wsjcpp::SqlSelect &pending2 = builder3.subSelect("t").colum("id");
+  pending2.where().equal("status", 1);
+  builder3.update("t").set("flag", 1).where().inSelect("id", pending2);
+  if (builder3.coalesce() != 0) {
+    std::cerr << "Expected no coalesce of updates with subqueries in where" << std::endl;
+    return -1;
+  }
+  if (checkStatements(builder3.statements(), {
+    "UPDATE t SET status = 2 WHERE id IN (SELECT id FROM t WHERE status = 1)",
+    "UPDATE t SET flag = 1 WHERE id IN (SELECT id FROM t WHERE status = 1)",
+  }) != 0) {
+    return -1;
+  }
+
+  // upserts with the same key in one statement fail in PostgreSQL
+  wsjcpp::SqlBuilder builderPg(wsjcpp::SqlBuilderForDatabase::POSTGRESQL);
+  builderPg.insertInto("counters").addColums({"id", "v"}).onConflict({"id"}).doUpdateSet().row(1, 2);
+  builderPg.insertInto("counters").addColums({"id", "v"}).onConflict({"id"}).doUpdateSet().row(1, 3);
+  builderPg.insertInto("counters").addColums({"id", "v"}).onConflict({"id"}).doNothing().row(2, 1);
+  builderPg.insertInto("counters").addColums({"id", "v"}).onConflict({"id"}).doNothing().row(2, 1);
+  if (builderPg.coalesce() != 1) {
+    std::cerr << "Expected only inserts with do nothing to be coalesced" << std::endl;
+    return -1;
+  }
+  if (checkStatements(builderPg.statements(), {
+    "INSERT INTO counters(id, v) VALUES(1, 2) ON CONFLICT(id) DO UPDATE SET v = excluded.v",
+    "INSERT INTO counters(id, v) VALUES(1, 3) ON CONFLICT(id) DO UPDATE SET v = excluded.v",
+    "INSERT INTO counters(id, v) VALUES(2, 1), (2, 1) ON CONFLICT(id) DO NOTHING",
+  }) != 0) {
+    return -1;
+  }
+
+  return 0;
+}
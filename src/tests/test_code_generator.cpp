@@ -0,0 +1,152 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+
+int main() {
+  wsjcpp::SqlCodeGenerator generator;
+  bool parsed = generator.parseSpec(
+    "-- name: findUserByPass\n"
+    "-- param: pass string\n"
+    "SELECT id, name\n"
+    "  FROM users\n"
+    "  WHERE pass = ? AND name <> 'what?';\n"
+    "\n"
+    "-- name: countUsers\n"
+    "SELECT COUNT(*) FROM users;\n"
+  );
+  if (!parsed) {
+    for (auto err : generator.errors()) {
+      std::cerr << err << std::endl;
+    }
+    return -1;
+  }
+
+  std::string code = generator.generateHeader("queries");
+  std::string codeExpected =
+    "// Automatically generated by wsjcpp-sql-builder, do not edit\n"
+    "#pragma once\n"
+    "\n"
+    "#include <string>\n"
+    "#include <wsjcpp_sql_builder.h>\n"
+    "\n"
+    "namespace queries {\n"
+    "\n"
+    "inline constexpr char findUserByPassSql[] = \"SELECT id, name FROM users WHERE pass = ? AND name <> 'what?'\";\n"
+    "\n"
+    "template<class TDialect = wsjcpp::SqlDialectSqlite3>\n"
+    "inline std::string findUserByPass(const std::string &pass) {\n"
+    "  std::string ret;\n"
+    "  ret.reserve(60 + wsjcpp::SqlBuilderHelpers::maxValueSize(pass));\n"
+    "  ret.append(findUserByPassSql, 40);\n"
+    "  wsjcpp::SqlBuilderHelpers::appendValue<TDialect>(ret, pass);\n"
+    "  ret.append(findUserByPassSql + 41, 20);\n"
+    "  return ret;\n"
+    "}\n"
+    "\n"
+    "inline constexpr char countUsersSql[] = \"SELECT COUNT(*) FROM users\";\n"
+    "\n"
+    "inline std::string countUsers() {\n"
+    "  return std::string(countUsersSql, 26);\n"
+    "}\n"
+    "\n"
+    "} // namespace queries\n"
+  ;
+  if (code != codeExpected) {
+    std::cerr
+      << "Expected:" << std::endl
+      << "   {" << codeExpected << "}" << std::endl
+      << ", but got:" << std::endl
+      << "   {" << code << "}" << std::endl
+    ;
+    return -1;
+  }
+
+  // the same as generated function does
+  const auto &query = generator.queries()[0];
+  std::string sqlQuery;
+  sqlQuery.reserve(query.sql().size() - 1 + wsjcpp::SqlBuilderHelpers::maxValueSize("x"));
+  std::size_t capacity = sqlQuery.capacity();
+  sqlQuery.append(query.sql(), 0, query.slots()[0]);
+  wsjcpp::SqlBuilderHelpers::appendValue<wsjcpp::SqlDialectSqlite3>(sqlQuery, "x");
+  sqlQuery.append(query.sql(), query.slots()[0] + 1);
+  if (sqlQuery.capacity() != capacity) {
+    std::cerr << "Expected the reserved buffer is not reallocated" << std::endl;
+    return -1;
+  }
+  std::string sqlQueryExpected = "SELECT id, name FROM users WHERE pass = 'x' AND name <> 'what?'";
+  if (sqlQuery != sqlQueryExpected) {
+    std::cerr << "Expected: " << sqlQueryExpected << ", but got: " << sqlQuery << std::endl;
+    return -1;
+  }
+
+  wsjcpp::SqlCodeGenerator wrong;
+  if (wrong.parseSpec("-- name: q1\n-- param: id uuid\nSELECT * FROM t WHERE id = ? AND x = ?")) {
+    std::cerr << "Expected errors for unknown type and mismatched placeholders" << std::endl;
+    return -1;
+  }
+  if (wrong.errors().size() != 2) {
+    std::cerr << "Expected 2 errors, but got " << wrong.errors().size() << std::endl;
+    return -1;
+  }
+
+  // names of generated functions and constants
+  wsjcpp::SqlCodeGenerator duplicates;
+  if (duplicates.parseSpec(
+    "-- name: findUser\nSELECT 1;\n"
+    "-- name: findUser\nSELECT 2;\n"
+    "-- name: findUserSql\nSELECT 3;\n"
+    "-- name: delete\nSELECT 4;\n"
+    "-- name: q2\n-- param: id int\n-- param: id int\n-- param: ret int\nSELECT ?;\n"
+  )) {
+    std::cerr << "Expected errors for duplicate and invalid names" << std::endl;
+    return -1;
+  }
+  if (duplicates.errors().size() != 5) {
+    for (auto err : duplicates.errors()) {
+      std::cerr << err << std::endl;
+    }
+    std::cerr << "Expected 5 errors, but got " << duplicates.errors().size() << std::endl;
+    return -1;
+  }
+
+  // the next spec can not redefine queries of the previous one
+  if (generator.parseSpec("-- name: countUsers\nSELECT 1;\n")) {
+    std::cerr << "Expected error for query name from the previous spec" << std::endl;
+    return -1;
+  }
+
+  if (wsjcpp::SqlCodeGenerator::isIdentifier("class") || wsjcpp::SqlCodeGenerator::isIdentifier("1q")
+    || !wsjcpp::SqlCodeGenerator::isIdentifier("queries")) {
+    std::cerr << "Unexpected result of isIdentifier" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
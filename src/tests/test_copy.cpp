@@ -0,0 +1,144 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+
+int checkBytes(const std::string &got, const std::string &expected) {
+  if (got != expected) {
+    std::cerr << "Expected " << expected.size() << " bytes:" << std::endl << "   {";
+    for (unsigned char c : expected) {
+      std::cerr << " " << (int)c;
+    }
+    std::cerr << "}" << std::endl << ", but got " << got.size() << " bytes:" << std::endl << "   {";
+    for (unsigned char c : got) {
+      std::cerr << " " << (int)c;
+    }
+    std::cerr << "}" << std::endl;
+    return -1;
+  }
+  return 0;
+}
+
+int main() {
+  wsjcpp::SqlBuilder builder(wsjcpp::SqlBuilderForDatabase::POSTGRESQL);
+  wsjcpp::SqlCopy &copyText = builder.copyInto("users")
+    .addColums({"id", "name", "note"})
+    .row(1, "a\tb", "")
+    .val(2).val("c\\d\n").valNull()
+    .finish();
+
+  if (builder.hasErrors()) {
+    std::cerr << "Builder has some errors" << std::endl;
+    return -1;
+  }
+  if (copyText.sql() != "COPY users(id, name, note) FROM STDIN") {
+    std::cerr << "Unexpected sql: " << copyText.sql() << std::endl;
+    return -1;
+  }
+  if (copyText.rowsCount() != 2) {
+    std::cerr << "Expected 2 rows, but got " << copyText.rowsCount() << std::endl;
+    return -1;
+  }
+  if (checkBytes(copyText.payload(), "1\ta\\tb\t\n2\tc\\\\d\\n\t\\N\n") != 0) {
+    return -1;
+  }
+
+  // float point values are not rounded in text format
+  wsjcpp::SqlBuilder builderFloat(wsjcpp::SqlBuilderForDatabase::POSTGRESQL);
+  wsjcpp::SqlCopy &copyFloat = builderFloat.copyInto("measures")
+    .addColums({"tiny", "huge", "ratio"})
+    .row(1e-7, 1.7976931348623157e308, 0.1f)
+    .row(-2.5e-300, 12345678901234567890.0, 3.0f)
+    .finish();
+  if (checkBytes(copyFloat.payload(), "1e-07\t1.7976931348623157e+308\t0.1\n-2.5e-300\t12345678901234567168\t3\n") != 0) {
+    return -1;
+  }
+
+  // golden payload of binary format
+  wsjcpp::SqlCopy &copyBinary = builder.copyInto("users")
+    .setFormat(wsjcpp::SqlCopyFormat::BINARY)
+    .addColums({"id", "name", "score"})
+    .row(1, "ab", 1.5)
+    .row(2L, "", 0.0f)
+    .val(3).valNull().valNull()
+    .finish();
+
+  if (copyBinary.sql() != "COPY users(id, name, score) FROM STDIN (FORMAT binary)") {
+    std::cerr << "Unexpected sql: " << copyBinary.sql() << std::endl;
+    return -1;
+  }
+  std::string golden(
+    "PGCOPY\n\377\r\n\0" "\0\0\0\0" "\0\0\0\0"
+    "\0\3" "\0\0\0\4" "\0\0\0\1" "\0\0\0\2" "ab" "\0\0\0\10" "\x3F\xF8\0\0\0\0\0\0"
+    "\0\3" "\0\0\0\10" "\0\0\0\0\0\0\0\2" "\0\0\0\0" "\0\0\0\4" "\0\0\0\0"
+    "\0\3" "\0\0\0\4" "\0\0\0\3" "\xFF\xFF\xFF\xFF" "\xFF\xFF\xFF\xFF"
+    "\xFF\xFF",
+    19 + 2 + 8 + 6 + 12 + 2 + 12 + 4 + 8 + 2 + 8 + 8 + 2
+  );
+  if (checkBytes(copyBinary.payload(), golden) != 0) {
+    return -1;
+  }
+
+  // sink gets the payload by parts of full rows
+  wsjcpp::SqlCopyStringSink sink;
+  wsjcpp::SqlCopy &copySink = builder.copyInto("users").addColums({"id", "name"}).setSink(&sink, 12);
+  copySink.row(1, "first");
+  if (sink.data().size() != 0) {
+    std::cerr << "Expected empty sink until the buffer is full" << std::endl;
+    return -1;
+  }
+  copySink.row(2, "second").row(3, "x");
+  if (checkBytes(sink.data(), "1\tfirst\n2\tsecond\n") != 0) {
+    return -1;
+  }
+  copySink.finish();
+  if (checkBytes(sink.data(), "1\tfirst\n2\tsecond\n3\tx\n") != 0 || copySink.payload().size() != 0) {
+    return -1;
+  }
+
+  if (builder.statements().size() != 3 || builder.hasErrors()) {
+    std::cerr << "Expected 3 statements without errors" << std::endl;
+    return -1;
+  }
+
+  builder.copyInto("users").addColums({"id", "name"}).row(1);
+  if (!builder.hasErrors()) {
+    std::cerr << "Expected error for row with wrong count of values" << std::endl;
+    return -1;
+  }
+
+  wsjcpp::SqlBuilder builder2;
+  builder2.copyInto("users");
+  if (!builder2.hasErrors()) {
+    std::cerr << "Expected error for COPY in SQLite3" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,137 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+template<class TBuilder>
+std::string insertWithBackslash(TBuilder &builder) {
+  builder.insertInto("t1").colum("c1").val("it's C:\\temp");
+  return builder.sql();
+}
+
+// ANSI FETCH FIRST instead of LIMIT
+class SqlDialectFetchFirst : public wsjcpp::SqlDialectSqlite3 {
+public:
+  static std::string limitOffset(long limit, long offset) {
+    std::string ret;
+    if (offset > 0) {
+      ret += " OFFSET " + std::to_string(offset) + " ROWS";
+    }
+    if (limit >= 0) {
+      ret += " FETCH FIRST " + std::to_string(limit) + " ROWS ONLY";
+    }
+    return ret;
+  }
+};
+
+// Oracle-like numbered placeholders ':1', ':2'
+class SqlDialectColonPlaceholders : public wsjcpp::SqlDialectSqlite3 {
+public:
+  static constexpr std::size_t placeholder(std::size_t index, char *out) {
+    std::size_t ret = wsjcpp::SqlDialectPostgreSQL::placeholder(index, out);
+    if (out != nullptr) {
+      out[0] = ':';
+    }
+    return ret;
+  }
+};
+
+int main() {
+  wsjcpp::SqlBuilder sqlite;
+  wsjcpp::BasicSqlBuilder<wsjcpp::SqlDialectPostgreSQL> postgres;
+  wsjcpp::BasicSqlBuilder<wsjcpp::SqlDialectMySQL> mysql;
+
+  if (postgres.databaseType() != wsjcpp::SqlBuilderForDatabase::POSTGRESQL) {
+    std::cerr << "Expected postgresql database type" << std::endl;
+    return -1;
+  }
+
+  int ret = 0;
+  ret += checkSql("sqlite", insertWithBackslash(sqlite), "INSERT INTO t1(c1) VALUES('it''s C:\\temp')");
+  ret += checkSql("postgres", insertWithBackslash(postgres), "INSERT INTO t1(c1) VALUES('it''s C:\\temp')");
+  ret += checkSql("mysql", insertWithBackslash(mysql), "INSERT INTO t1(c1) VALUES('it''s C:\\\\temp')");
+
+  mysql.clear();
+  mysql.update("t1").set("c1", "a\"b").where().equal("c2", "x\\");
+  ret += checkSql("mysql update", mysql.sql(), "UPDATE t1 SET c1 = 'a\\\"b' WHERE c2 = 'x\\\\'");
+
+  ret += checkSql("sqlite limit", sqlite.dialect().limitOffset(10, 20), " LIMIT 10 OFFSET 20");
+  ret += checkSql("sqlite offset", sqlite.dialect().limitOffset(-1, 20), " LIMIT -1 OFFSET 20");
+  ret += checkSql("postgres offset", postgres.dialect().limitOffset(-1, 20), " OFFSET 20");
+  ret += checkSql("mysql limit", mysql.dialect().limitOffset(10, 20), " LIMIT 20, 10");
+  ret += checkSql("sqlite none", sqlite.dialect().limitOffset(-1, 0), "");
+
+  ret += checkSql("sqlite placeholder", sqlite.dialect().placeholder(2), "?");
+  ret += checkSql("postgres placeholder", postgres.dialect().placeholder(12), "$12");
+  ret += checkSql("mysql placeholder", mysql.dialect().placeholder(2), "?");
+  ret += checkSql("sqlite identifier", sqlite.dialect().quoteIdentifier("name"), "\"name\"");
+  ret += checkSql("postgres identifier", postgres.dialect().quoteIdentifier("my\"col"), "\"my\"\"col\"");
+  ret += checkSql("mysql identifier", mysql.dialect().quoteIdentifier("or`der"), "`or``der`");
+
+  // only reserved words are quoted in column lists
+  mysql.clear();
+  mysql.insertInto("t1").colum("id").colum("order").val(1).val(2);
+  ret += checkSql("mysql reserved", mysql.sql(), "INSERT INTO t1(id, `order`) VALUES(1, 2)");
+  postgres.clear();
+  postgres.update("t1").set("Group", 1).set("total", 2).where().equal("id", 1);
+  ret += checkSql("postgres reserved", postgres.sql(), "UPDATE t1 SET \"Group\" = 1, total = 2 WHERE id = 1");
+
+  // rendered by the policy type, not by database type
+  wsjcpp::BasicSqlBuilder<SqlDialectFetchFirst> fetchFirst;
+  fetchFirst.selectFrom("t1").colum("c1").limit(5);
+  ret += checkSql("own policy", fetchFirst.sql(), "SELECT c1 FROM t1 FETCH FIRST 5 ROWS ONLY");
+
+  // database type of the policy builder can not be changed
+  wsjcpp::BasicSqlBuilder<wsjcpp::SqlDialectPostgreSQL> fixed;
+  wsjcpp::SqlBuilder &fixedRef = fixed;
+  fixedRef.setDatabaseType(wsjcpp::SqlBuilderForDatabase::MYSQL);
+  if (!fixed.hasErrors()) {
+    std::cerr << "Expected error for changed database type of BasicSqlBuilder" << std::endl;
+    ret = -1;
+  }
+  fixed.selectFrom("t1").limit(1).offset(5);
+  ret += checkSql("fixed postgres", fixed.sql(), "SELECT * FROM t1 LIMIT 1 OFFSET 5");
+
+  constexpr auto select = wsjcpp::SqlStatic::selectFrom("t1").where().equal("c1").sql();
+  ret += checkSql(
+    "static mysql",
+    select.render<wsjcpp::SqlDialectMySQL>("C:\\temp"),
+    "SELECT * FROM t1 WHERE c1 = 'C:\\\\temp'"
+  );
+
+  // placeholders of prepared statements by the policy
+  constexpr auto update = wsjcpp::SqlStatic::update("t1").set("c1").where().equal("c2").sql();
+  ret += checkSql("static sqlite", update.sql<wsjcpp::SqlDialectSqlite3>().str(), "UPDATE t1 SET c1 = ? WHERE c2 = ?");
+  ret += checkSql("static postgres", update.sql<wsjcpp::SqlDialectPostgreSQL>().str(), "UPDATE t1 SET c1 = $1 WHERE c2 = $2");
+  constexpr auto colon = update.sql<SqlDialectColonPlaceholders>();
+  ret += checkSql("static own policy", colon.str(), "UPDATE t1 SET c1 = :1 WHERE c2 = :2");
+
+  return ret == 0 ? 0 : -1;
+}
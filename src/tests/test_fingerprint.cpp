@@ -0,0 +1,134 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+
+int main() {
+  wsjcpp::SqlBuilder builder;
+  uint64_t fp1 = builder.selectFrom("users")
+    .colum("id")
+    .colum("name")
+    .where()
+      .equal("pass", "64d878e22cd5046d569bf826869034caf5feab24")
+      .or_()
+      .subCondition()
+        .moreThen("age", 18)
+        .lessThen("age", 60)
+      .finishSubCondition()
+    .endWhere()
+    .fingerprint();
+
+  // same shape, other values
+  uint64_t fp2 = builder.selectFrom("users")
+    .colum("id")
+    .colum("name")
+    .where()
+      .equal("pass", "other")
+      .or_()
+      .subCondition()
+        .moreThen("age", 21)
+        .lessThen("age", 99)
+      .finishSubCondition()
+    .endWhere()
+    .fingerprint();
+
+  if (fp1 != fp2) {
+    std::cerr << "Expected equal fingerprints for the same shape" << std::endl;
+    return -1;
+  }
+
+  // other nesting
+  uint64_t fp3 = builder.selectFrom("users")
+    .colum("id")
+    .colum("name")
+    .where()
+      .equal("pass", "other")
+      .or_()
+      .subCondition()
+        .moreThen("age", 21)
+      .finishSubCondition()
+      .lessThen("age", 99)
+    .endWhere()
+    .fingerprint();
+
+  // other operator
+  uint64_t fp4 = builder.selectFrom("users")
+    .colum("id")
+    .colum("name")
+    .where()
+      .equal("pass", "other")
+      .and_()
+      .subCondition()
+        .moreThen("age", 21)
+        .lessThen("age", 99)
+      .finishSubCondition()
+    .endWhere()
+    .fingerprint();
+
+  uint64_t fp5 = builder.deleteFrom("users")
+    .where()
+      .equal("pass", "other")
+    .endWhere()
+    .fingerprint();
+
+  uint64_t fp6 = builder.deleteFrom("users2")
+    .where()
+      .equal("pass", "other")
+    .endWhere()
+    .fingerprint();
+
+  std::vector<uint64_t> fps = {fp1, fp3, fp4, fp5, fp6};
+  for (std::size_t i = 0; i < fps.size(); i++) {
+    for (std::size_t j = i + 1; j < fps.size(); j++) {
+      if (fps[i] == fps[j]) {
+        std::cerr << "Expected different fingerprints for " << i << " and " << j << std::endl;
+        return -1;
+      }
+    }
+  }
+
+  uint64_t fp7 = builder.update("users").set("name", "a").set("name", "b").fingerprint();
+  uint64_t fp8 = builder.update("users").set("name", 1).fingerprint();
+  if (fp7 != fp8) {
+    std::cerr << "Expected that repeated set does not change fingerprint" << std::endl;
+    return -1;
+  }
+
+  // 'IS NULL' is other shape
+  uint64_t fp9 = builder.selectFrom("users").where().equal("email", wsjcpp::SqlLiteral::null()).endWhere().fingerprint();
+  uint64_t fp10 = builder.selectFrom("users").where().equal("email", 5).endWhere().fingerprint();
+  uint64_t fp11 = builder.selectFrom("users").where().notEqual("email", wsjcpp::SqlLiteral::null()).endWhere().fingerprint();
+  uint64_t fp12 = builder.selectFrom("users").where().notEqual("email", "a").endWhere().fingerprint();
+  if (fp9 == fp10 || fp11 == fp12) {
+    std::cerr << "Expected different fingerprints for 'IS NULL' and '= value'" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
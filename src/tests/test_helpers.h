@@ -0,0 +1,63 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+// comparisons with output in the same format for all tests
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+inline int checkSql(const std::string &name, const std::string &got, const std::string &expected) {
+  if (got != expected) {
+    std::cerr
+      << name << ". Expected:" << std::endl
+      << "   {" << expected << "}" << std::endl
+      << ", but got:" << std::endl
+      << "   {" << got << "}" << std::endl
+    ;
+    return -1;
+  }
+  return 0;
+}
+
+inline int checkStatements(const std::vector<std::string> &statements, const std::vector<std::string> &expected) {
+  if (statements != expected) {
+    std::cerr << "Expected:" << std::endl;
+    for (auto statement : expected) {
+      std::cerr << "   {" << statement << "}" << std::endl;
+    }
+    std::cerr << ", but got:" << std::endl;
+    for (auto statement : statements) {
+      std::cerr << "   {" << statement << "}" << std::endl;
+    }
+    return -1;
+  }
+  return 0;
+}
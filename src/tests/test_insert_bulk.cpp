@@ -0,0 +1,120 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+
+int main() {
+  std::vector<int64_t> ids = {1, 2, 3, -4};
+  std::vector<double> scores = {0.5, 1.25, 0, 100};
+  uint8_t scoresValidity[] = {0b1011}; // third score is NULL
+  std::vector<std::string> names = {"a", "b'c", "d", "e"};
+
+  wsjcpp::SqlBulkColumns columns;
+  columns
+    .colum("id", ids)
+    .colum("score", scores, scoresValidity)
+    .colum("name", wsjcpp::SqlColumnSpan<std::string>(names.data(), names.size()))
+  ;
+
+  wsjcpp::SqlBuilder builder;
+  wsjcpp::SqlInsert &insert = builder.insertInto("scores").bulk(columns);
+  if (builder.hasErrors()) {
+    std::cerr << "Builder has some errors" << std::endl;
+    return -1;
+  }
+  if (insert.rowsCount() != 4) {
+    std::cerr << "Expected 4 rows, but got " << insert.rowsCount() << std::endl;
+    return -1;
+  }
+
+  std::string sqlExpected =
+    "INSERT INTO scores(id, score, name) VALUES"
+    "(1, 0.5, 'a'), (2, 1.25, 'b''c'), (3, NULL, 'd'), (-4, 100, 'e')";
+  if (builder.sql() != sqlExpected) {
+    std::cerr << "Expected:" << std::endl
+      << "   {" << sqlExpected << "}" << std::endl
+      << ", but got:" << std::endl
+      << "   {" << builder.sql() << "}" << std::endl;
+    return -1;
+  }
+
+  // the same shape as rows added by val(), but float point numbers are not rounded to 6 digits
+  wsjcpp::SqlBuilder builder2;
+  wsjcpp::SqlInsert &insert2 = builder2.insertInto("scores").addColums({"id", "score", "name"});
+  insert2.row(1L, 0.5, "a").row(2L, 1.25, "b'c").row(3L, wsjcpp::SqlLiteral::null(), "d").row(-4L, 100.0, "e");
+  if (insert.fingerprint() != insert2.fingerprint()) {
+    std::cerr << "Expected the same fingerprint as by val()" << std::endl;
+    return -1;
+  }
+
+  // bulk data can be mixed with the other rows and chunked (val() keeps std::to_string format)
+  wsjcpp::SqlChunkLimits limits;
+  limits.maxRows = 3;
+  insert.row(5L, 5.0, "f").setChunkLimits(limits);
+  std::vector<std::string> statementsExpected = {
+    "INSERT INTO scores(id, score, name) VALUES(1, 0.5, 'a'), (2, 1.25, 'b''c'), (3, NULL, 'd')",
+    "INSERT INTO scores(id, score, name) VALUES(-4, 100, 'e'), (5, 5.000000, 'f')",
+  };
+  if (builder.statements() != statementsExpected) {
+    std::cerr << "Unexpected statements:" << std::endl;
+    for (auto statement : builder.statements()) {
+      std::cerr << "   {" << statement << "}" << std::endl;
+    }
+    return -1;
+  }
+
+  // small and big values are not rounded
+  wsjcpp::SqlBuilder builderPrecision;
+  std::vector<double> measures = {1e-7, 0.5, 1.7976931348623157e308};
+  std::vector<float> ratios = {0.1f, 3e-9f, 2.0f};
+  builderPrecision.insertInto("measures").bulk(wsjcpp::SqlBulkColumns().colum("value", measures).colum("ratio", ratios));
+  if (builderPrecision.sql() != "INSERT INTO measures(value, ratio) VALUES(1e-07, 0.1), (0.5, 3e-09), (1.7976931348623157e+308, 2)") {
+    std::cerr << "Unexpected sql: " << builderPrecision.sql() << std::endl;
+    return -1;
+  }
+
+  // mysql escaping of strings
+  wsjcpp::SqlBuilder builder3(wsjcpp::SqlBuilderForDatabase::MYSQL);
+  std::vector<std::string> paths = {"c:\\tmp"};
+  builder3.insertInto("files").bulk(wsjcpp::SqlBulkColumns().colum("path", paths));
+  if (builder3.sql() != "INSERT INTO files(path) VALUES('c:\\\\tmp')") {
+    std::cerr << "Unexpected sql: " << builder3.sql() << std::endl;
+    return -1;
+  }
+
+  // columns with different sizes
+  std::vector<int> shortColumn = {1};
+  builder3.insertInto("scores").bulk(wsjcpp::SqlBulkColumns().colum("id", ids).colum("level", shortColumn));
+  if (!builder3.hasErrors()) {
+    std::cerr << "Expected error for columns with different sizes" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+int main() {
+  wsjcpp::SqlBuilder builder;
+  wsjcpp::SqlInsert &insert = builder.insertInto("table2")
+    .addColums({"col1", "col2"})
+    .row("a", 1)
+    .row("b", 2)
+    .val("c")
+    .val(3)
+    .newRow()
+    .row("d", 4)
+    .row("e", 5)
+  ;
+
+  if (builder.hasErrors()) {
+    std::cerr << "Builder has some errors" << std::endl;
+    return -1;
+  }
+  if (insert.rowsCount() != 5) {
+    std::cerr << "Expected 5 rows, but got " << insert.rowsCount() << std::endl;
+    return -1;
+  }
+
+  if (checkStatements(builder.statements(), {
+    "INSERT INTO table2(col1, col2) VALUES('a', 1), ('b', 2), ('c', 3), ('d', 4), ('e', 5)"
+  }) != 0) {
+    return -1;
+  }
+
+  wsjcpp::SqlChunkLimits limits;
+  limits.maxRows = 2;
+  insert.setChunkLimits(limits);
+  if (checkStatements(builder.statements(), {
+    "INSERT INTO table2(col1, col2) VALUES('a', 1), ('b', 2)",
+    "INSERT INTO table2(col1, col2) VALUES('c', 3), ('d', 4)",
+    "INSERT INTO table2(col1, col2) VALUES('e', 5)",
+  }) != 0) {
+    return -1;
+  }
+
+  limits = wsjcpp::SqlChunkLimits();
+  limits.maxVariables = 7; // 3 rows per statement
+  insert.setChunkLimits(limits);
+  if (checkStatements(builder.statements(), {
+    "INSERT INTO table2(col1, col2) VALUES('a', 1), ('b', 2), ('c', 3)",
+    "INSERT INTO table2(col1, col2) VALUES('d', 4), ('e', 5)",
+  }) != 0) {
+    return -1;
+  }
+
+  limits = wsjcpp::SqlChunkLimits();
+  limits.maxBytes = 60;
+  insert.setChunkLimits(limits);
+  if (checkStatements(builder.statements(), {
+    "INSERT INTO table2(col1, col2) VALUES('a', 1), ('b', 2)",
+    "INSERT INTO table2(col1, col2) VALUES('c', 3), ('d', 4)",
+    "INSERT INTO table2(col1, col2) VALUES('e', 5)",
+  }) != 0) {
+    return -1;
+  }
+
+  // current row is not finished by newRow()
+  builder.clear();
+  builder.insertInto("table2").addColums({"col1", "col2"}).row("a", 1).val("b").val(2);
+  if (builder.sql() != "INSERT INTO table2(col1, col2) VALUES('a', 1), ('b', 2)") {
+    std::cerr << "Unexpected sql: " << builder.sql() << std::endl;
+    return -1;
+  }
+
+  builder.clear();
+  builder.insertInto("table2").addColums({"col1", "col2"}).row("a");
+  if (!builder.hasErrors()) {
+    std::cerr << "Expected error for row with wrong count of values" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,79 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+int main() {
+  wsjcpp::SqlBuilder builder;
+  wsjcpp::SqlInsert &insert = builder.insertInto("logs_archive").addColums({"id", "msg"});
+  insert.selectFrom("logs")
+    .colum("id")
+    .colum("msg")
+    .where()
+      .lessThen("created", 1000)
+  ;
+  if (builder.hasErrors()) {
+    std::cerr << "Builder has some errors" << std::endl;
+    return -1;
+  }
+  if (checkSql("insert select", builder.sql(), "INSERT INTO logs_archive(id, msg) SELECT id, msg FROM logs WHERE created < 1000") != 0) {
+    return -1;
+  }
+
+  // shape of the select is a part of fingerprint
+  wsjcpp::SqlBuilder builder2;
+  wsjcpp::SqlInsert &insert2 = builder2.insertInto("logs_archive").addColums({"id", "msg"});
+  insert2.selectFrom("logs").colum("id").colum("msg");
+  if (insert.fingerprint() == insert2.fingerprint()) {
+    std::cerr << "Expected different fingerprints for different selects" << std::endl;
+    return -1;
+  }
+
+  // upsert after select without where in sqlite
+  insert2.onConflict({"id"}).doNothing();
+  if (checkSql("sqlite do nothing", builder2.sql(), "INSERT INTO logs_archive(id, msg) SELECT id, msg FROM logs WHERE true ON CONFLICT(id) DO NOTHING") != 0) {
+    return -1;
+  }
+
+  wsjcpp::SqlBuilder builderPg(wsjcpp::SqlBuilderForDatabase::POSTGRESQL);
+  builderPg.insertInto("users_copy").addColums({"id"}).onConflict({"id"}).doNothing().selectFrom("users").colum("id");
+  if (checkSql("postgres do nothing", builderPg.sql(), "INSERT INTO users_copy(id) SELECT id FROM users ON CONFLICT(id) DO NOTHING") != 0) {
+    return -1;
+  }
+
+  // select without columns
+  builderPg.clear();
+  builderPg.insertInto("users_copy").addColums({"id", "name"}).selectFrom("users");
+  if (checkSql("select all", builderPg.sql(), "INSERT INTO users_copy(id, name) SELECT * FROM users") != 0) {
+    return -1;
+  }
+
+  return 0;
+}
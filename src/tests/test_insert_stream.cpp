@@ -0,0 +1,119 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <algorithm>
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+class StatementsSink : public wsjcpp::ISqlStatementSink {
+public:
+  virtual void write(const std::string &statement) override {
+    statements.push_back(statement);
+  }
+  std::vector<std::string> statements;
+};
+
+class User {
+public:
+  long id;
+  std::string name;
+};
+
+int main() {
+  wsjcpp::SqlBuilder builder;
+  wsjcpp::SqlChunkLimits limits;
+  limits.maxRows = 3;
+  wsjcpp::SqlInsert &insert = builder.insertInto("numbers")
+    .addColums({"n"})
+    .setChunkLimits(limits)
+    .row(0)
+  ;
+
+  StatementsSink sink;
+  int next = 1;
+  std::size_t maxRowsInMemory = 0;
+  std::size_t written = insert.stream([&](wsjcpp::SqlInsert &insert) {
+    maxRowsInMemory = std::max(maxRowsInMemory, insert.rowsCount());
+    if (next > 7) {
+      return false;
+    }
+    insert.val(next++);
+    return true;
+  }, sink);
+
+  if (written != 3) {
+    std::cerr << "Expected 3 statements, but got " << written << std::endl;
+    return -1;
+  }
+  if (maxRowsInMemory > 3) {
+    std::cerr << "Expected not more than one chunk in memory, but got " << maxRowsInMemory << " rows" << std::endl;
+    return -1;
+  }
+  if (checkStatements(sink.statements, {
+    "INSERT INTO numbers(n) VALUES(0), (1), (2)",
+    "INSERT INTO numbers(n) VALUES(3), (4), (5)",
+    "INSERT INTO numbers(n) VALUES(6), (7)",
+  }) != 0) {
+    return -1;
+  }
+  if (builder.statements().size() != 0 || builder.hasErrors()) {
+    std::cerr << "Expected no statements in builder after stream" << std::endl;
+    return -1;
+  }
+
+  // input range of objects, limits by size of statement
+  wsjcpp::SqlRowMapping<User> mapping("users");
+  mapping.primaryKey("id", &User::id).colum("name", &User::name);
+  std::vector<User> users = {{1, "a"}, {2, "b"}, {3, "c"}};
+  limits = wsjcpp::SqlChunkLimits();
+  limits.maxBytes = 50;
+  StatementsSink sink2;
+  builder.insertInto("users")
+    .setChunkLimits(limits)
+    .onConflict({"id"})
+    .doNothing()
+    .streamObjects(mapping, users, sink2);
+  if (checkStatements(sink2.statements, {
+    "INSERT INTO users(id, name) VALUES(1, 'a') ON CONFLICT(id) DO NOTHING",
+    "INSERT INTO users(id, name) VALUES(2, 'b') ON CONFLICT(id) DO NOTHING",
+    "INSERT INTO users(id, name) VALUES(3, 'c') ON CONFLICT(id) DO NOTHING",
+  }) != 0) {
+    return -1;
+  }
+
+  // empty source
+  StatementsSink sink3;
+  std::vector<User> empty;
+  if (builder.insertInto("users").streamObjects(mapping, empty, sink3) != 0 || sink3.statements.size() != 0) {
+    std::cerr << "Expected no statements for empty source" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,106 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+int main() {
+  wsjcpp::SqlBuilder builder;
+  builder.insertInto("users")
+    .addColums({"id", "name", "level"})
+    .row(1, "a", 10)
+    .row(2, "b", 20)
+    .onConflict({"id"})
+    .doUpdateSet()
+  ;
+  builder.insertInto("users")
+    .addColums({"id", "name", "level"})
+    .row(3, "c", 30)
+    .onConflict({"id"})
+    .doUpdateSet({"level"})
+  ;
+  builder.insertInto("tags").addColums({"name"}).row("x").doNothing();
+  if (builder.hasErrors()) {
+    std::cerr << "Builder has some errors" << std::endl;
+    return -1;
+  }
+  if (checkStatements(builder.statements(), {
+    "INSERT INTO users(id, name, level) VALUES(1, 'a', 10), (2, 'b', 20)"
+    " ON CONFLICT(id) DO UPDATE SET name = excluded.name, level = excluded.level",
+    "INSERT INTO users(id, name, level) VALUES(3, 'c', 30) ON CONFLICT(id) DO UPDATE SET level = excluded.level",
+    "INSERT INTO tags(name) VALUES('x') ON CONFLICT DO NOTHING",
+  }) != 0) {
+    return -1;
+  }
+
+  // every chunk has own clause
+  wsjcpp::SqlBuilder builderPg(wsjcpp::SqlBuilderForDatabase::POSTGRESQL);
+  wsjcpp::SqlChunkLimits limits;
+  limits.maxRows = 2;
+  builderPg.insertInto("users")
+    .addColums({"id", "name"})
+    .setChunkLimits(limits)
+    .row(1, "a").row(2, "b").row(3, "c")
+    .onConflict({"id"})
+    .doNothing()
+  ;
+  if (checkStatements(builderPg.statements(), {
+    "INSERT INTO users(id, name) VALUES(1, 'a'), (2, 'b') ON CONFLICT(id) DO NOTHING",
+    "INSERT INTO users(id, name) VALUES(3, 'c') ON CONFLICT(id) DO NOTHING",
+  }) != 0) {
+    return -1;
+  }
+
+  wsjcpp::SqlBuilder builderMysql(wsjcpp::SqlBuilderForDatabase::MYSQL);
+  builderMysql.insertInto("users").addColums({"id", "name"}).row(1, "a").onConflict({"id"}).doUpdateSet();
+  builderMysql.insertInto("users").addColums({"id", "name"}).row(2, "b").doNothing();
+  if (checkStatements(builderMysql.statements(), {
+    "INSERT INTO users(id, name) VALUES(1, 'a') ON DUPLICATE KEY UPDATE name = VALUES(name)",
+    "INSERT INTO users(id, name) VALUES(2, 'b') ON DUPLICATE KEY UPDATE id = id",
+  }) != 0) {
+    return -1;
+  }
+
+  // conflict handling is a part of the query shape
+  wsjcpp::SqlBuilder builder2;
+  wsjcpp::SqlInsert &insert1 = builder2.insertInto("users").addColums({"id", "name"}).row(1, "a");
+  wsjcpp::SqlInsert &insert2 = builder2.insertInto("users").addColums({"id", "name"}).row(1, "a").onConflict({"id"}).doNothing();
+  if (insert1.fingerprint() == insert2.fingerprint()) {
+    std::cerr << "Expected different fingerprints for insert with and without ON CONFLICT" << std::endl;
+    return -1;
+  }
+
+  builder2.insertInto("users").addColums({"id", "name"}).row(1, "a").onConflict().doUpdateSet();
+  if (!builder2.hasErrors()) {
+    std::cerr << "Expected error for DO UPDATE without conflict target" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,131 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+
+int checkWarnings(const std::vector<std::string> &got, const std::vector<std::string> &expected) {
+  bool equal = got.size() == expected.size();
+  for (std::size_t i = 0; equal && i < got.size(); i++) {
+    equal = got[i] == expected[i];
+  }
+  if (!equal) {
+    std::cerr << "Expected:" << std::endl;
+    for (auto warning : expected) {
+      std::cerr << "   {" << warning << "}" << std::endl;
+    }
+    std::cerr << ", but got:" << std::endl;
+    for (auto warning : got) {
+      std::cerr << "   {" << warning << "}" << std::endl;
+    }
+    return -1;
+  }
+  return 0;
+}
+
+int main() {
+#ifdef NDEBUG
+  return 0; // lint works only in debug builds
+#endif
+  int ret = 0;
+  wsjcpp::SqlBuilder builder;
+  builder.registerLargeTable("events");
+
+  builder.selectFrom("events");
+  builder.selectFrom("events").colum("id").limit(10);
+  builder.update("events").set("archived", 1);
+  builder.deleteFrom("events");
+  builder.deleteFrom("users"); // not large
+  builder.selectFrom("users").colum("id").where()
+    .like("name", "%abc%")
+    .or_()
+    .like("name", "abc%");
+  builder.selectFrom("users").colum("id").where()
+    .equal("level", 1).or_().equal("level", 2).or_().equal("level", 3);
+  builder.selectFrom("users").colum("id").where()
+    .equal("email", "a@b").or_().equal("phone", "123");
+  builder.selectFrom("users").colum("id").where().in("id", std::vector<int>{1, 2, 3});
+  builder.selectFrom("users").colum("id").where().inArray("id", std::vector<int>{1, 2, 3});
+
+  ret += checkWarnings(builder.lint(), {
+    "SELECT * from 'events', all columns are read and sent",
+    "SELECT from large table 'events' without where and limit",
+    "UPDATE of large table 'events' without where",
+    "DELETE from large table 'events' without where",
+    "LIKE '%abc%' with leading '%' on 'users.name', index can not be used",
+    "OR chain of 3 equals on 'users.level', better in()",
+    "OR across different columns of 'users' (email, phone), one index can not be used",
+    "IN list of 'users.id' changes statement text by count of values, inArray() keeps the same shape",
+  });
+  if (builder.hasErrors()) {
+    std::cerr << "Expected warnings are not errors of builder" << std::endl;
+    ret -= 1;
+  }
+
+  // nested conditions, options
+  builder.clear();
+  builder.selectFrom("users").colum("id").where()
+    .equal("status", 1)
+    .subCondition()
+      .equal("level", 1).or_().equal("level", 2)
+    .finishSubCondition();
+  wsjcpp::SqlLintOptions options;
+  options.wideOrChain = 2;
+  ret += checkWarnings(builder.lint(options), {
+    "OR chain of 2 equals on 'users.level', better in()",
+  });
+
+  // one value with ', ' inside is not a list
+  builder.clear();
+  builder.selectFrom("users").colum("id").where().in("name", std::vector<std::string>{"Doe, John"});
+  ret += checkWarnings(builder.lint(), {});
+
+  // having, insert ... select, subqueries and CTE
+  wsjcpp::SqlBuilder builder2;
+  builder2.registerLargeTable("events");
+  builder2.selectFrom("users").colum("level").count().groupBy("level").having()
+    .equal("COUNT(*)", 1).or_().equal("COUNT(*)", 2).or_().equal("COUNT(*)", 3);
+  builder2.insertInto("events_copy").addColums({"id"}).selectFrom("events").colum("id");
+  wsjcpp::SqlSelect &banned = builder2.subSelect("bans").colum("user_id");
+  banned.where().like("reason", "%spam%");
+  builder2.selectFrom("users").colum("id").where().inSelect("id", banned);
+  wsjcpp::SqlSelect &recent = builder2.subSelect("events").colum("user_id");
+  builder2.selectFrom("active").with("active", recent).colum("user_id");
+  wsjcpp::SqlSelect &exists = builder2.subSelect("orders");
+  exists.where().equalColum("orders.user_id", "users.id");
+  builder2.selectFrom("users").colum("id").where().exists(exists);
+  ret += checkWarnings(builder2.lint(), {
+    "OR chain of 3 equals on 'users.COUNT(*)', better in()",
+    "SELECT from large table 'events' without where and limit",
+    "LIKE '%spam%' with leading '%' on 'bans.reason', index can not be used",
+    "SELECT from large table 'events' without where and limit",
+  });
+
+  return ret == 0 ? 0 : -1;
+}
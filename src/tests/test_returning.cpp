@@ -0,0 +1,78 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+int main() {
+  wsjcpp::SqlBuilder builder;
+  wsjcpp::SqlChunkLimits limits;
+  limits.maxRows = 1;
+  builder.insertInto("users")
+    .addColums({"name"})
+    .setChunkLimits(limits)
+    .row("a")
+    .row("b")
+    .onConflict({"name"})
+    .doNothing()
+    .returning({"id", "created"})
+  ;
+  builder.update("users").set("level", 2).returning({"id"}).where().equal("name", "a");
+  builder.deleteFrom("users").returning({"id", "id"}).where().equal("name", "b");
+  if (builder.hasErrors()) {
+    std::cerr << "Builder has some errors" << std::endl;
+    return -1;
+  }
+  if (checkStatements(builder.statements(), {
+    "INSERT INTO users(name) VALUES('a') ON CONFLICT(name) DO NOTHING RETURNING id, created",
+    "INSERT INTO users(name) VALUES('b') ON CONFLICT(name) DO NOTHING RETURNING id, created",
+    "UPDATE users SET level = 2 WHERE name = 'a' RETURNING id",
+    "DELETE FROM users WHERE name = 'b' RETURNING id",
+  }) != 0) {
+    return -1;
+  }
+
+  // queries with own results are not merged
+  wsjcpp::SqlBuilder builder2(wsjcpp::SqlBuilderForDatabase::POSTGRESQL);
+  builder2.insertInto("users").addColums({"name"}).row("a").returning({"id"});
+  builder2.insertInto("users").addColums({"name"}).row("b").returning({"id"});
+  if (builder2.coalesce() != 0) {
+    std::cerr << "Expected nothing to coalesce" << std::endl;
+    return -1;
+  }
+
+  wsjcpp::SqlBuilder builderMysql(wsjcpp::SqlBuilderForDatabase::MYSQL);
+  builderMysql.deleteFrom("users").returning({"id"});
+  if (!builderMysql.hasErrors()) {
+    std::cerr << "Expected error for RETURNING in MySQL" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,101 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <optional>
+#include <wsjcpp_sql_builder.h>
+
+struct User {
+  long id;
+  std::string name;
+  double rating;
+  std::optional<std::string> email;
+};
+
+int main() {
+  wsjcpp::SqlRowMapping<User> mapping("users");
+  mapping
+    .primaryKey("id", &User::id)
+    .colum("name", &User::name)
+    .colum("rating", &User::rating)
+    .colum("email", &User::email)
+  ;
+
+  std::vector<User> users = {
+    {1, "user1", 1.5, std::nullopt},
+    {2, "user'2", 2.0, std::string("u2@example.com")},
+  };
+
+  wsjcpp::SqlBuilder builder;
+  builder.insertObjects(mapping, users);
+  builder.updateObjects(mapping, std::vector<User>{users[1]});
+
+  if (builder.hasErrors()) {
+    std::cerr << "Builder has some errors" << std::endl;
+    return -1;
+  }
+  std::string sqlQuery = builder.sql();
+  std::string sqlQueryExpected =
+    "INSERT INTO users(id, name, rating, email) VALUES(1, 'user1', 1.5, NULL), (2, 'user''2', 2, 'u2@example.com')\n"
+    "UPDATE users SET name = 'user''2', rating = 2, email = 'u2@example.com' WHERE id = 2";
+  if (sqlQuery != sqlQueryExpected) {
+    std::cerr
+      << "Expected:" << std::endl
+      << "   {" << sqlQueryExpected << "}" << std::endl
+      << ", but got:" << std::endl
+      << "   {" << sqlQuery << "}" << std::endl
+    ;
+    return -1;
+  }
+
+  wsjcpp::SqlRowMapping<User> mappingWithoutKey("users");
+  mappingWithoutKey.colum("name", &User::name);
+  builder.clear();
+  builder.update("users").object(mappingWithoutKey, users[0]);
+  if (!builder.hasErrors()) {
+    std::cerr << "Expected error for update by mapping without primary key" << std::endl;
+    return -1;
+  }
+
+  // precision of small values
+  wsjcpp::SqlBuilder precision;
+  precision.insertObjects(mapping, std::vector<User>{{3, "user3", 1e-7, std::nullopt}});
+  sqlQuery = precision.sql();
+  sqlQueryExpected = "INSERT INTO users(id, name, rating, email) VALUES(3, 'user3', 1e-07, NULL)";
+  if (sqlQuery != sqlQueryExpected) {
+    std::cerr
+      << "Expected:" << std::endl
+      << "   {" << sqlQueryExpected << "}" << std::endl
+      << ", but got:" << std::endl
+      << "   {" << sqlQuery << "}" << std::endl
+    ;
+    return -1;
+  }
+
+  return 0;
+}
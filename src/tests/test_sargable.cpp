@@ -0,0 +1,98 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+int main() {
+  int ret = 0;
+  wsjcpp::SqlBuilder builder;
+
+  builder.selectFrom("users").colum("id").where()
+    .like("name", "abc%")
+    .or_()
+    .like("name", "%abc%") // not a prefix
+    .or_()
+    .like("name", "a_c%")  // wildcard inside
+    .or_()
+    .subCondition()
+      .lessThen("10", wsjcpp::SqlLiteral("age"))
+      .moreOrEqual("'x'", wsjcpp::SqlLiteral("u.code"))
+      .equal("level", 1)
+    .finishSubCondition();
+  wsjcpp::SqlRewriteReport report = builder.rewriteSargable();
+  ret += checkSql(
+    "rewritten",
+    builder.sql(),
+    "SELECT id FROM users WHERE name >= 'abc' AND name < 'abd' OR name LIKE '%abc%' OR name LIKE 'a_c%'"
+    " OR (age > 10 AND u.code <= 'x' AND level = 1)"
+  );
+  if (report.rewrites.size() != 3) {
+    std::cerr << "Expected 3 rewrites, but got " << report.rewrites.size() << std::endl;
+    return -1;
+  }
+  ret += checkSql("report like", report.rewrites[0], "name LIKE 'abc%' -> name >= 'abc' AND name < 'abd'");
+  ret += checkSql("report swap", report.rewrites[1], "10 < age -> age > 10");
+
+  builder.clear();
+  builder.deleteFrom("logs").where().like("path", "/var/z%%");
+  builder.rewriteSargable();
+  ret += checkSql("upper bound", builder.sql(), "DELETE FROM logs WHERE path >= '/var/z' AND path < '/var/{'");
+
+  // MySQL uses index range for prefix LIKE itself
+  wsjcpp::SqlBuilder mysql(wsjcpp::SqlBuilderForDatabase::MYSQL);
+  mysql.selectFrom("users").colum("id").where().like("name", "abc%");
+  report = mysql.rewriteSargable();
+  ret += checkSql("mysql", mysql.sql(), "SELECT id FROM users WHERE name LIKE 'abc%'");
+  if (report.rewrites.size() != 0) {
+    std::cerr << "Expected no rewrites for mysql" << std::endl;
+    ret -= 1;
+  }
+
+  // the same shape before the pass, but only the prefix is rewritten
+  wsjcpp::SqlBuilder prefix;
+  wsjcpp::SqlSelect &prefixSelect = prefix.selectFrom("users").colum("id");
+  prefixSelect.where().like("name", "abc%");
+  wsjcpp::SqlBuilder pattern;
+  wsjcpp::SqlSelect &patternSelect = pattern.selectFrom("users").colum("id");
+  patternSelect.where().like("name", "a%c");
+  if (prefixSelect.fingerprint() != patternSelect.fingerprint()) {
+    std::cerr << "Expected the same fingerprints before rewrite" << std::endl;
+    ret -= 1;
+  }
+  prefix.rewriteSargable();
+  pattern.rewriteSargable();
+  if (prefixSelect.fingerprint() == patternSelect.fingerprint()) {
+    std::cerr << "Expected different fingerprints after rewrite" << std::endl;
+    ret -= 1;
+  }
+
+  return ret == 0 ? 0 : -1;
+}
@@ -68,6 +68,33 @@ int main() {
     return -1;
   }
 
+  // by default must be added and after sub condition too
+  builder.clear();
+  builder.selectFrom("table1")
+    .colum("col1")
+    .where()
+      .subCondition()
+        .equal("col1", "1")
+        .or_()
+        .equal("col1", "2")
+      .finishSubCondition()
+      .equal("col2", "3")
+      .subCondition()
+        .lessThen("col3", 4)
+      .finishSubCondition()
+  ;
+  sqlQuery = builder.sql();
+  sqlQueryExpected = "SELECT col1 FROM table1 WHERE (col1 = '1' OR col1 = '2') AND col2 = '3' AND (col3 < 4)";
+  if (sqlQuery != sqlQueryExpected) {
+    std::cerr
+      << "Expected:" << std::endl
+      << "   " << sqlQueryExpected << std::endl
+      << ", but got:" << std::endl
+      << "   " << sqlQuery << std::endl
+    ;
+    return -1;
+  }
+
   builder.clear();
   sqlQuery = builder.sql();
   if (sqlQuery != "") {
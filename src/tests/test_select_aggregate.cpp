@@ -0,0 +1,86 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+int main() {
+  int ret = 0;
+  wsjcpp::SqlBuilder builder;
+
+  builder.selectFrom("orders")
+    .colum("user_id")
+    .count("*", "cnt")
+    .sum("amount", "total")
+    .min("created")
+    .max("created")
+    .avg("amount")
+    .where()
+      .equal("status", "paid")
+    .endWhere()
+    .groupBy("user_id")
+    .having()
+      .moreThen("COUNT(*)", 10)
+    .endWhere()
+    .orderBy("total", true)
+    .orderBy("user_id")
+    .limit(20)
+    .offset(40);
+  ret += checkSql(
+    "aggregate",
+    builder.sql(),
+    "SELECT user_id, COUNT(*) AS cnt, SUM(amount) AS total, MIN(created), MAX(created), AVG(amount)"
+    " FROM orders WHERE status = 'paid' GROUP BY user_id HAVING COUNT(*) > 10"
+    " ORDER BY total DESC, user_id LIMIT 20 OFFSET 40"
+  );
+
+  // limit and offset are not a part of the shape
+  builder.clear();
+  uint64_t fp1 = builder.selectFrom("users").orderBy("id").limit(10).offset(10).fingerprint();
+  uint64_t fp2 = builder.selectFrom("users").orderBy("id").limit(10).offset(20).fingerprint();
+  uint64_t fp3 = builder.selectFrom("users").orderBy("id", true).limit(10).offset(20).fingerprint();
+  if (fp1 != fp2 || fp2 == fp3) {
+    std::cerr << "Expected fingerprint without limit values, but with order" << std::endl;
+    ret -= 1;
+  }
+
+  wsjcpp::SqlBuilder mysql(wsjcpp::SqlBuilderForDatabase::MYSQL);
+  mysql.selectFrom("users").count().limit(5).offset(10);
+  ret += checkSql("mysql limit", mysql.sql(), "SELECT COUNT(*) FROM users LIMIT 10, 5");
+  mysql.clear();
+  mysql.selectFrom("users").colum("id").offset(10);
+  ret += checkSql("mysql offset", mysql.sql(), "SELECT id FROM users LIMIT 10, 18446744073709551615");
+
+  wsjcpp::SqlBuilder postgres(wsjcpp::SqlBuilderForDatabase::POSTGRESQL);
+  postgres.selectFrom("users").colum("id").offset(10);
+  ret += checkSql("postgres offset", postgres.sql(), "SELECT id FROM users OFFSET 10");
+
+  return ret == 0 ? 0 : -1;
+}
@@ -0,0 +1,95 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+int main() {
+  int ret = 0;
+  wsjcpp::SqlBuilder builder;
+
+  builder.selectFrom("users").as("u")
+    .colum("u.id")
+    .colum("u.name")
+    .colum("o.id", "order_id")
+    .colum("p.title")
+    .innerJoin("orders", "o")
+      .equalColum("o.user_id", "u.id")
+      .equal("o.status", "paid")
+    .endWhere()
+    .leftJoin("products", "p")
+      .equalColum("p.id", "o.product_id")
+    .endWhere()
+    .where()
+      .moreThen("u.level", 10)
+    .endWhere()
+    .orderBy("u.id");
+  ret += checkSql(
+    "join",
+    builder.sql(),
+    "SELECT u.id, u.name, o.id AS order_id, p.title FROM users AS u"
+    " INNER JOIN orders AS o ON o.user_id = u.id AND o.status = 'paid'"
+    " LEFT JOIN products AS p ON p.id = o.product_id"
+    " WHERE u.level > 10 ORDER BY u.id"
+  );
+
+  // aggregate of children in one statement instead of a query per parent
+  builder.clear();
+  builder.selectFrom("users")
+    .colum("users.id")
+    .count("orders.id", "orders_count")
+    .leftJoin("orders").equalColum("orders.user_id", "users.id").endWhere()
+    .groupBy("users.id");
+  ret += checkSql(
+    "left join count",
+    builder.sql(),
+    "SELECT users.id, COUNT(orders.id) AS orders_count FROM users"
+    " LEFT JOIN orders ON orders.user_id = users.id GROUP BY users.id"
+  );
+
+  builder.clear();
+  uint64_t fp1 = builder.selectFrom("a").innerJoin("b").equalColum("b.a_id", "a.id").endWhere().fingerprint();
+  uint64_t fp2 = builder.selectFrom("a").innerJoin("b").equalColum("b.a_id", "a.parent_id").endWhere().fingerprint();
+  uint64_t fp3 = builder.selectFrom("a").leftJoin("b").equalColum("b.a_id", "a.id").endWhere().fingerprint();
+  if (fp1 == fp2 || fp1 == fp3) {
+    std::cerr << "Expected different fingerprints for different joins" << std::endl;
+    ret -= 1;
+  }
+
+  builder.clear();
+  builder.selectFrom("a").innerJoin("b").endWhere();
+  builder.sql();
+  if (!builder.hasErrors()) {
+    std::cerr << "Expected error for join without ON" << std::endl;
+    ret -= 1;
+  }
+
+  return ret == 0 ? 0 : -1;
+}
@@ -0,0 +1,120 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+std::string hexToken(const std::string &data) {
+  const char hex[] = "0123456789abcdef";
+  std::string ret;
+  for (unsigned char c : data) {
+    ret += hex[c >> 4];
+    ret += hex[c & 0xF];
+  }
+  return ret;
+}
+
+int main() {
+  int ret = 0;
+  wsjcpp::SqlBuilder builder;
+
+  // first page
+  wsjcpp::SqlSelect &first = builder.selectFrom("users").colum("id").colum("name");
+  first.keyset({"created", "id"}, 100);
+  ret += checkSql("first page", builder.sql(), "SELECT id, name FROM users ORDER BY created, id LIMIT 100");
+  std::string token = first.nextCursor("2026-01-01 10:00", 42);
+
+  // next page
+  builder.clear();
+  builder.selectFrom("users").colum("id").colum("name")
+    .keyset({"created", "id"}, 100, token)
+    .where().equal("level", 1).or_().equal("level", 2);
+  ret += checkSql(
+    "next page",
+    builder.sql(),
+    "SELECT id, name FROM users WHERE (level = 1 OR level = 2) AND (created, id) > ('2026-01-01 10:00', 42) ORDER BY created, id LIMIT 100"
+  );
+
+  builder.clear();
+  builder.selectFrom("users").colum("id").keyset({"id"}, 10, wsjcpp::SqlKeysetCursor::of(42), true);
+  ret += checkSql("desc", builder.sql(), "SELECT id FROM users WHERE id < 42 ORDER BY id DESC LIMIT 10");
+
+  // typed values are escaped again, so a changed token does not inject sql
+  builder.clear();
+  std::string evil = wsjcpp::SqlKeysetCursor::of("x' OR 1 = 1 --").token();
+  builder.selectFrom("users").colum("id").keyset({"name"}, 10, evil);
+  ret += checkSql("escaped", builder.sql(), "SELECT id FROM users WHERE name > 'x'' OR 1 = 1 --' ORDER BY name LIMIT 10");
+
+  wsjcpp::SqlKeysetCursor cursor;
+  if (cursor.parse(wsjcpp::SqlKeysetCursor::of("a").token().replace(0, 2, "69"))) { // 't' -> 'i'
+    std::cerr << "Expected not number value is rejected" << std::endl;
+    ret -= 1;
+  }
+  // malformed tokens: no separator, no length, wrong type, length out of the token, odd size
+  for (std::string malformed : {
+    hexToken("i12"), hexToken("i"), hexToken("i1:1i"), hexToken("i:1"), hexToken("x1:1"),
+    hexToken("i5:1"), hexToken("i99999999999999999999999:1"), hexToken("t1:a").substr(1),
+  }) {
+    if (cursor.parse(malformed)) {
+      std::cerr << "Expected malformed token is rejected: " << malformed << std::endl;
+      ret -= 1;
+    }
+  }
+  if (!cursor.parse(hexToken("i2:42t1:a")) || cursor.size() != 2) {
+    std::cerr << "Expected valid token is parsed" << std::endl;
+    ret -= 1;
+  }
+  builder.clear();
+  builder.selectFrom("users").keyset({"id"}, 10, "zz");
+  if (!builder.hasErrors()) {
+    std::cerr << "Expected error for malformed cursor" << std::endl;
+    ret -= 1;
+  }
+
+  builder.clear();
+  builder.selectFrom("users").keyset({"id"}, 10);
+  uint64_t fp1 = builder.selectFrom("users").keyset({"id"}, 10, wsjcpp::SqlKeysetCursor::of(1)).fingerprint();
+  uint64_t fp2 = builder.selectFrom("users").keyset({"id"}, 10, wsjcpp::SqlKeysetCursor::of(2)).fingerprint();
+  if (fp1 != fp2) {
+    std::cerr << "Expected the same fingerprint for pages" << std::endl;
+    ret -= 1;
+  }
+
+  // expanded form
+  wsjcpp::SqlBuilder mysql(wsjcpp::SqlBuilderForDatabase::MYSQL);
+  mysql.selectFrom("users").colum("id").keyset({"a", "b", "c"}, 5, wsjcpp::SqlKeysetCursor::of(1, 2.5, "x"));
+  ret += checkSql(
+    "mysql expanded",
+    mysql.sql(),
+    "SELECT id FROM users WHERE a >= 1 AND (a > 1 OR (a = 1 AND b > 2.5) OR (a = 1 AND b = 2.5 AND c > 'x')) ORDER BY a, b, c LIMIT 5"
+  );
+
+  return ret == 0 ? 0 : -1;
+}
@@ -0,0 +1,126 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+int checkCount(const std::string &name, std::size_t got, std::size_t expected) {
+  return checkSql(name, std::to_string(got), std::to_string(expected));
+}
+
+int main() {
+  int ret = 0;
+  wsjcpp::SqlBuilder builder;
+
+  builder.selectFrom("users").colum("id").where()
+    .subCondition()
+      .equal("level", 1)
+    .finishSubCondition()
+    .equal("status", "active")
+    .equal("level", 1)
+    .subCondition()
+      .equal("x", 1).or_().equal("x", 2).or_().equal("x", 3).or_().equal("x", 2)
+    .finishSubCondition()
+    .subCondition()
+      .moreThen("age", 18).lessThen("age", 60)
+    .finishSubCondition();
+  wsjcpp::SqlSimplifyReport report = builder.simplify();
+  ret += checkSql(
+    "simplified",
+    builder.sql(),
+    "SELECT id FROM users WHERE level = 1 AND status = 'active' AND x IN (1, 2, 3) AND age > 18 AND age < 60"
+  );
+  ret += checkCount("flattened", report.flattenedGroups, 3);
+  ret += checkCount("duplicates", report.removedDuplicates, 2);
+  ret += checkCount("in", report.rewrittenToIn, 1);
+
+  // OR groups: x OR (a OR b), equal groups
+  builder.clear();
+  builder.selectFrom("users").colum("id").where()
+    .equal("a", 1).equal("b", 2)
+    .or_()
+    .subCondition()
+      .equal("c", 3).or_().equal("d", 4)
+    .finishSubCondition()
+    .or_()
+    .equal("b", 2).equal("a", 1);
+  builder.simplify();
+  ret += checkSql("or groups", builder.sql(), "SELECT id FROM users WHERE a = 1 AND b = 2 OR c = 3 OR d = 4 OR b = 2 AND a = 1");
+
+  // contradictions
+  builder.clear();
+  builder.deleteFrom("sessions").where().equal("user_id", 1).equal("user_id", 2);
+  builder.update("users").set("online", 0).where().equal("id", 1).notEqual("id", 1);
+  builder.update("users").set("online", 1).where()
+    .equal("id", 1).equal("id", 2.0)
+    .or_()
+    .equal("id", 3).equal("id", 3.0);
+  builder.selectFrom("users").colum("id").where().equal("email", wsjcpp::SqlLiteral::null()).equal("email", "a@b");
+  builder.selectFrom("users").colum("id").where().equal("name", "a").equal("name", "A");
+  report = builder.simplify();
+  ret += checkCount("skipped", report.skippedQueries, 2);
+  ret += checkCount("contradictions", report.contradictions, 4);
+  std::vector<std::string> statements = builder.statements();
+  ret += checkCount("statements", statements.size(), 3);
+  ret += checkSql("partly false", statements[0], "UPDATE users SET online = 1 WHERE id = 3 AND id = 3.000000");
+  ret += checkSql("false select", statements[1], "SELECT id FROM users WHERE 1 = 0");
+  ret += checkSql("strings by collation", statements[2], "SELECT id FROM users WHERE name = 'a' AND name = 'A'");
+
+  // contradiction in the nested group is counted once
+  wsjcpp::SqlBuilder nested;
+  nested.deleteFrom("sessions").where()
+    .equal("active", 1)
+    .subCondition()
+      .equal("user_id", 1).equal("user_id", 2)
+    .finishSubCondition();
+  report = nested.simplify();
+  ret += checkCount("nested contradictions", report.contradictions, 1);
+  ret += checkCount("nested skipped", report.skippedQueries, 1);
+
+  // the same shape before simplify, but different statements after
+  wsjcpp::SqlBuilder same;
+  wsjcpp::SqlSelect &sameSelect = same.selectFrom("users").colum("id");
+  sameSelect.where().equal("id", 1).equal("id", 1);
+  wsjcpp::SqlBuilder other;
+  wsjcpp::SqlSelect &otherSelect = other.selectFrom("users").colum("id");
+  otherSelect.where().equal("id", 1).equal("id", 2);
+  if (sameSelect.fingerprint() != otherSelect.fingerprint()) {
+    std::cerr << "Expected the same fingerprints before simplify" << std::endl;
+    ret -= 1;
+  }
+  same.simplify();
+  other.simplify();
+  if (sameSelect.fingerprint() == otherSelect.fingerprint()) {
+    std::cerr << "Expected different fingerprints after simplify: " << same.sql() << " / " << other.sql() << std::endl;
+    ret -= 1;
+  }
+
+  return ret == 0 ? 0 : -1;
+}
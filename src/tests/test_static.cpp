@@ -0,0 +1,122 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+
+template<std::size_t N, std::size_t M>
+constexpr bool equalText(const std::array<char, N> &text, const char (&expected)[M]) {
+  if (N != M) {
+    return false;
+  }
+  for (std::size_t i = 0; i < N; i++) {
+    if (text[i] != expected[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main() {
+  constexpr auto select = wsjcpp::SqlStatic::selectFrom("users")
+    .colum("id")
+    .colum("name")
+    .colum("pass")
+    .where()
+      .equal("pass")
+      .or_()
+      .subCondition()
+        .moreThen("age")
+        .lessThen("age")
+      .finishSubCondition()
+    .sql();
+  static_assert(select.placeholders() == 3, "select must have 3 placeholders");
+  static_assert(
+    equalText(select.text(), "SELECT id, name, pass FROM users WHERE pass = ? OR (age > ? AND age < ?)"),
+    "unexpected select"
+  );
+
+  constexpr auto insert = wsjcpp::SqlStatic::insertInto("table2").colum("col1").colum("col2").colum("col3").sql();
+  static_assert(equalText(insert.text(), "INSERT INTO table2(col1, col2, col3) VALUES(?, ?, ?)"), "unexpected insert");
+
+  constexpr auto update = wsjcpp::SqlStatic::update("table3").set("col1").set("col2").where().equal("id").sql();
+  static_assert(equalText(update.text(), "UPDATE table3 SET col1 = ?, col2 = ? WHERE id = ?"), "unexpected update");
+
+  constexpr auto del = wsjcpp::SqlStatic::deleteFrom("table4").where().notEqual("col1").sql();
+  static_assert(equalText(del.text(), "DELETE FROM table4 WHERE col1 <> ?"), "unexpected delete");
+
+  constexpr auto selectAll = wsjcpp::SqlStatic::selectFrom("t").colum("c1", "a").sql();
+  static_assert(equalText(selectAll.text(), "SELECT c1 AS a FROM t"), "unexpected select with alias");
+
+  constexpr auto selectPg = select.sql<wsjcpp::SqlDialectPostgreSQL>();
+  static_assert(
+    equalText(selectPg.array(), "SELECT id, name, pass FROM users WHERE pass = $1 OR (age > $2 AND age < $3)"),
+    "unexpected select for postgresql"
+  );
+  static_assert(
+    equalText(select.sql<wsjcpp::SqlDialectMySQL>().array(), "SELECT id, name, pass FROM users WHERE pass = ? OR (age > ? AND age < ?)"),
+    "unexpected select for mysql"
+  );
+  constexpr auto wide = wsjcpp::SqlStatic::insertInto("t")
+    .colum("c1").colum("c2").colum("c3").colum("c4").colum("c5").colum("c6").colum("c7").colum("c8").colum("c9").colum("c10")
+    .sql();
+  static_assert(
+    equalText(
+      wide.sql<wsjcpp::SqlDialectPostgreSQL>().array(),
+      "INSERT INTO t(c1, c2, c3, c4, c5, c6, c7, c8, c9, c10) VALUES($1, $2, $3, $4, $5, $6, $7, $8, $9, $10)"
+    ),
+    "unexpected insert for postgresql"
+  );
+
+  std::string sqlQuery = select.render("64d878e22cd5046d569bf826869034caf5feab24", 18, 60);
+  std::string sqlQueryExpected =
+    "SELECT id, name, pass FROM users WHERE pass = '64d878e22cd5046d569bf826869034caf5feab24' OR (age > 18 AND age < 60)";
+  if (sqlQuery != sqlQueryExpected) {
+    std::cerr
+      << "Expected:" << std::endl
+      << "   {" << sqlQueryExpected << "}" << std::endl
+      << ", but got:" << std::endl
+      << "   {" << sqlQuery << "}" << std::endl
+    ;
+    return -1;
+  }
+
+  sqlQuery = insert.render(std::string("val1"), 1, 2.0);
+  sqlQueryExpected = "INSERT INTO table2(col1, col2, col3) VALUES('val1', 1, 2.000000)";
+  if (sqlQuery != sqlQueryExpected) {
+    std::cerr
+      << "Expected:" << std::endl
+      << "   {" << sqlQueryExpected << "}" << std::endl
+      << ", but got:" << std::endl
+      << "   {" << sqlQuery << "}" << std::endl
+    ;
+    return -1;
+  }
+
+  return 0;
+}
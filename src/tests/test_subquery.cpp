@@ -0,0 +1,93 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+int main() {
+  int ret = 0;
+  wsjcpp::SqlBuilder builder;
+
+  wsjcpp::SqlSelect &paid = builder.subSelect("orders").colum("user_id").where().equal("status", "paid").endWhere();
+  builder.selectFrom("users").colum("name").where().inSelect("id", paid).notInSelect("id", builder.subSelect("bans").colum("user_id"));
+  ret += checkSql(
+    "in select",
+    builder.sql(),
+    "SELECT name FROM users WHERE id IN (SELECT user_id FROM orders WHERE status = 'paid')"
+    " AND id NOT IN (SELECT user_id FROM bans)"
+  );
+
+  builder.clear();
+  wsjcpp::SqlSelect &orders = builder.subSelect("orders").as("o").colum("1").where().equalColum("o.user_id", "u.id").endWhere();
+  builder.selectFrom("users").as("u").colum("u.name").where().exists(orders).or_().notExists(orders);
+  ret += checkSql(
+    "exists",
+    builder.sql(),
+    "SELECT u.name FROM users AS u WHERE EXISTS (SELECT 1 FROM orders AS o WHERE o.user_id = u.id)"
+    " OR NOT EXISTS (SELECT 1 FROM orders AS o WHERE o.user_id = u.id)"
+  );
+
+  // CTE
+  builder.clear();
+  wsjcpp::SqlSelect &active = builder.subSelect("users").colum("id").where().moreThen("last_login", 1000).endWhere();
+  builder.selectFrom("active").count("*").with("active", active);
+  ret += checkSql(
+    "with select",
+    builder.sql(),
+    "WITH active AS (SELECT id FROM users WHERE last_login > 1000) SELECT COUNT(*) FROM active"
+  );
+
+  builder.clear();
+  wsjcpp::SqlSelect &old = builder.subSelect("sessions").colum("id").where().lessThen("created", 10).endWhere();
+  builder.deleteFrom("sessions").with("old", old).where().inSelect("id", builder.subSelect("old").colum("id"));
+  builder.update("users").with("old", old).set("online", 0).where().inSelect("session_id", builder.subSelect("old").colum("id"));
+  std::vector<std::string> statements = builder.statements();
+  ret += checkSql(
+    "with delete",
+    statements[0],
+    "WITH old AS (SELECT id FROM sessions WHERE created < 10) DELETE FROM sessions WHERE id IN (SELECT id FROM old)"
+  );
+  ret += checkSql(
+    "with update",
+    statements[1],
+    "WITH old AS (SELECT id FROM sessions WHERE created < 10) UPDATE users SET online = 0 WHERE session_id IN (SELECT id FROM old)"
+  );
+
+  // shape of subquery is a part of the fingerprint
+  builder.clear();
+  uint64_t fp1 = builder.selectFrom("users").where().inSelect("id", builder.subSelect("a").colum("user_id")).endWhere().fingerprint();
+  uint64_t fp2 = builder.selectFrom("users").where().inSelect("id", builder.subSelect("b").colum("user_id")).endWhere().fingerprint();
+  if (fp1 == fp2) {
+    std::cerr << "Expected different fingerprints for different subqueries" << std::endl;
+    ret -= 1;
+  }
+
+  return ret == 0 ? 0 : -1;
+}
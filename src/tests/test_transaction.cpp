@@ -0,0 +1,123 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+int main() {
+  wsjcpp::SqlBuilder builder;
+  builder.insertInto("logs").addColums({"msg"}).row("a");
+  builder.insertInto("logs").addColums({"msg"}).row("b");
+  builder.deleteFrom("logs").where().equal("msg", "c");
+
+  if (checkStatements(builder.statements(), {
+    "INSERT INTO logs(msg) VALUES('a')",
+    "INSERT INTO logs(msg) VALUES('b')",
+    "DELETE FROM logs WHERE msg = 'c'",
+  }) != 0) {
+    return -1;
+  }
+
+  builder.setTransaction(true);
+  if (checkStatements(builder.statements(), {
+    "BEGIN",
+    "INSERT INTO logs(msg) VALUES('a')",
+    "INSERT INTO logs(msg) VALUES('b')",
+    "DELETE FROM logs WHERE msg = 'c'",
+    "COMMIT",
+  }) != 0) {
+    return -1;
+  }
+
+  std::string scriptExpected =
+    "BEGIN;\n"
+    "INSERT INTO logs(msg) VALUES('a');\n"
+    "INSERT INTO logs(msg) VALUES('b');\n"
+    "DELETE FROM logs WHERE msg = 'c';\n"
+    "COMMIT;\n";
+  if (builder.script() != scriptExpected) {
+    std::cerr << "Expected:" << std::endl
+      << "   {" << scriptExpected << "}" << std::endl
+      << ", but got:" << std::endl
+      << "   {" << builder.script() << "}" << std::endl;
+    return -1;
+  }
+
+  wsjcpp::SqlTransactionLimits limits;
+  limits.maxStatements = 2;
+  builder.setTransaction(true, limits);
+  if (checkStatements(builder.statements(), {
+    "BEGIN",
+    "INSERT INTO logs(msg) VALUES('a')",
+    "INSERT INTO logs(msg) VALUES('b')",
+    "COMMIT",
+    "BEGIN",
+    "DELETE FROM logs WHERE msg = 'c'",
+    "COMMIT",
+  }) != 0) {
+    return -1;
+  }
+
+  limits = wsjcpp::SqlTransactionLimits();
+  limits.maxBytes = 40;
+  builder.setTransaction(true, limits);
+  if (checkStatements(builder.statements(), {
+    "BEGIN",
+    "INSERT INTO logs(msg) VALUES('a')",
+    "COMMIT",
+    "BEGIN",
+    "INSERT INTO logs(msg) VALUES('b')",
+    "COMMIT",
+    "BEGIN",
+    "DELETE FROM logs WHERE msg = 'c'",
+    "COMMIT",
+  }) != 0) {
+    return -1;
+  }
+
+  wsjcpp::SqlBuilder builderMysql(wsjcpp::SqlBuilderForDatabase::MYSQL);
+  builderMysql.setTransaction(true);
+  builderMysql.deleteFrom("logs");
+  if (checkStatements(builderMysql.statements(), {
+    "START TRANSACTION",
+    "DELETE FROM logs",
+    "COMMIT",
+  }) != 0) {
+    return -1;
+  }
+
+  // nothing to commit
+  builderMysql.clear();
+  if (builderMysql.statements().size() != 0) {
+    std::cerr << "Expected no statements for empty builder" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,186 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+
+class Users : public wsjcpp::SqlTableDef {
+public:
+  static constexpr char name[] = "users";
+};
+
+class UsersId : public wsjcpp::SqlColumnDef<Users, long, wsjcpp::SqlColumnKind::PRIMARY_KEY> {
+public:
+  static constexpr char name[] = "id";
+};
+
+class UsersName : public wsjcpp::SqlColumnDef<Users, std::string> {
+public:
+  static constexpr char name[] = "name";
+};
+
+class UsersRating : public wsjcpp::SqlColumnDef<Users, double, wsjcpp::SqlColumnKind::NULLABLE> {
+public:
+  static constexpr char name[] = "rating";
+};
+
+class Orders : public wsjcpp::SqlTableDef {
+public:
+  static constexpr char name[] = "orders";
+};
+
+class OrdersUserId : public wsjcpp::SqlColumnDef<Orders, long> {
+public:
+  static constexpr char name[] = "user_id";
+};
+
+static_assert(UsersId::primaryKey && !UsersId::nullable, "id must be primary key");
+static_assert(UsersRating::nullable, "rating must be nullable");
+// typed queries do not compile with columns of other tables (selectFrom<Users>().colum<OrdersUserId>())
+static_assert(wsjcpp::SqlIsTableColumn<Users, UsersId>::value, "id is column of users");
+static_assert(!wsjcpp::SqlIsTableColumn<Users, OrdersUserId>::value, "user_id is not column of users");
+
+int checkSql(wsjcpp::SqlBuilder &builder, const std::string &sqlQueryExpected) {
+  if (builder.hasErrors()) {
+    std::cerr << "Builder has some errors" << std::endl;
+    return -1;
+  }
+  std::string sqlQuery = builder.sql();
+  if (sqlQuery != sqlQueryExpected) {
+    std::cerr
+      << "Expected:" << std::endl
+      << "   {" << sqlQueryExpected << "}" << std::endl
+      << ", but got:" << std::endl
+      << "   {" << sqlQuery << "}" << std::endl
+    ;
+    return -1;
+  }
+  builder.clear();
+  return 0;
+}
+
+int main() {
+  wsjcpp::SqlBuilder builder;
+  builder.selectFrom<Users>()
+    .colum<UsersId>()
+    .colum<UsersName>("n")
+    .where()
+      .equal<UsersName>("user1")
+      .or_()
+      .moreThen<UsersId>(10)
+      .or_()
+      .equal<UsersRating>(std::nullopt)
+  ;
+  if (checkSql(builder, "SELECT id, name AS n FROM users WHERE name = 'user1' OR id > 10 OR rating IS NULL") != 0) {
+    return -1;
+  }
+
+  builder.insertInto<Users>()
+    .colum<UsersId>()
+    .colum<UsersName>()
+    .colum<UsersRating>()
+    .val<UsersId>(1)
+    .val<UsersName>("user1")
+    .val<UsersRating>(std::optional<double>())
+  ;
+  if (checkSql(builder, "INSERT INTO users(id, name, rating) VALUES(1, 'user1', NULL)") != 0) {
+    return -1;
+  }
+
+  // small values are not rounded to 0.000000
+  builder.insertInto<Users>()
+    .colum<UsersId>()
+    .colum<UsersRating>()
+    .val<UsersId>(2)
+    .val<UsersRating>(1e-7)
+  ;
+  if (checkSql(builder, "INSERT INTO users(id, rating) VALUES(2, 1e-07)") != 0) {
+    return -1;
+  }
+
+  builder.update<Users>()
+    .set<UsersName>(std::string("user2"))
+    .set<UsersRating>(std::optional<double>(4.5))
+    .where()
+      .equal<UsersId>(1)
+  ;
+  if (checkSql(builder, "UPDATE users SET name = 'user2', rating = 4.5 WHERE id = 1") != 0) {
+    return -1;
+  }
+
+  builder.deleteFrom<Users>().where().notEqual<UsersRating>(std::nullopt);
+  if (checkSql(builder, "DELETE FROM users WHERE rating IS NOT NULL") != 0) {
+    return -1;
+  }
+
+  // sub conditions and endWhere() keep the table type
+  builder.selectFrom<Users>()
+    .where()
+      .equal<UsersName>("user1")
+      .subCondition()
+        .moreThen<UsersId>(1)
+        .or_()
+        .lessThen<UsersRating>(2.5)
+      .finishSubCondition()
+    .endWhere()
+    .colum<UsersId>()
+  ;
+  if (checkSql(builder, "SELECT id FROM users WHERE name = 'user1' AND (id > 1 OR rating < 2.5)") != 0) {
+    return -1;
+  }
+
+  // columns of joined tables are allowed in untyped queries
+  builder.selectFrom("users")
+    .colum<UsersId>()
+    .innerJoin("orders")
+      .equal<OrdersUserId>(5L)
+    .endWhere()
+  ;
+  if (checkSql(builder, "SELECT id FROM users INNER JOIN orders ON user_id = 5") != 0) {
+    return -1;
+  }
+
+#ifndef NDEBUG
+  // untyped queries are checked at runtime
+  wsjcpp::SqlBuilder wrongColum;
+  wrongColum.selectFrom("users").colum<OrdersUserId>();
+  if (!wrongColum.hasErrors()) {
+    std::cerr << "Expected error for column of other table in select" << std::endl;
+    return -1;
+  }
+
+  wsjcpp::SqlBuilder wrongWhere;
+  wrongWhere.selectFrom("users").colum<UsersId>().where().equal<OrdersUserId>(5L);
+  if (!wrongWhere.hasErrors()) {
+    std::cerr << "Expected error for column of other table in where" << std::endl;
+    return -1;
+  }
+#endif
+
+  return 0;
+}
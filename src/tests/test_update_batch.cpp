@@ -0,0 +1,107 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+int main() {
+  wsjcpp::SqlBuilder builder;
+  wsjcpp::SqlUpdateBatch &batch = builder.updateBatch("users", "id")
+    .addColums({"name", "level"})
+    .row(1, "a", 10)
+    .row(2, "b", 20)
+    .row(3, "c", wsjcpp::SqlLiteral::null())
+    .row(1, "a2", 11) // the last row wins
+  ;
+  if (builder.hasErrors()) {
+    std::cerr << "Builder has some errors" << std::endl;
+    return -1;
+  }
+  if (batch.rowsCount() != 3) {
+    std::cerr << "Expected 3 rows, but got " << batch.rowsCount() << std::endl;
+    return -1;
+  }
+  if (checkStatements(builder.statements(), {
+    "UPDATE users SET"
+    " name = CASE id WHEN 1 THEN 'a2' WHEN 2 THEN 'b' WHEN 3 THEN 'c' END,"
+    " level = CASE id WHEN 1 THEN 11 WHEN 2 THEN 20 WHEN 3 THEN NULL END"
+    " WHERE id IN (1, 2, 3)",
+  }) != 0) {
+    return -1;
+  }
+
+  wsjcpp::SqlChunkLimits limits;
+  limits.maxRows = 2;
+  batch.setChunkLimits(limits);
+  if (checkStatements(builder.statements(), {
+    "UPDATE users SET name = CASE id WHEN 1 THEN 'a2' WHEN 2 THEN 'b' END,"
+    " level = CASE id WHEN 1 THEN 11 WHEN 2 THEN 20 END WHERE id IN (1, 2)",
+    "UPDATE users SET name = CASE id WHEN 3 THEN 'c' END, level = CASE id WHEN 3 THEN NULL END WHERE id IN (3)",
+  }) != 0) {
+    return -1;
+  }
+
+  // size of every chunk is in limit
+  limits = wsjcpp::SqlChunkLimits();
+  limits.maxBytes = 145;
+  batch.setChunkLimits(limits);
+  for (auto statement : builder.statements()) {
+    if (statement.size() > limits.maxBytes) {
+      std::cerr << "Statement is bigger than limit: " << statement << std::endl;
+      return -1;
+    }
+  }
+  if (builder.statements().size() != 2) {
+    std::cerr << "Expected 2 statements, but got " << builder.statements().size() << std::endl;
+    return -1;
+  }
+
+  wsjcpp::SqlBuilder builderPg(wsjcpp::SqlBuilderForDatabase::POSTGRESQL);
+  builderPg.updateBatch("users", "id")
+    .addColums({"name", "level"})
+    .row(1, "a", 10)
+    .row(2, "b", 20)
+    .val(3).val("c").val(30) // current row is not finished by newRow()
+  ;
+  if (checkStatements(builderPg.statements(), {
+    "UPDATE users SET name = v.name, level = v.level"
+    " FROM (VALUES (1, 'a', 10), (2, 'b', 20), (3, 'c', 30)) AS v(id, name, level)"
+    " WHERE users.id = v.id",
+  }) != 0) {
+    return -1;
+  }
+
+  builderPg.updateBatch("users", "id").addColums({"name", "level"}).row(1, "a");
+  if (!builderPg.hasErrors()) {
+    std::cerr << "Expected error for row with wrong count of values" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
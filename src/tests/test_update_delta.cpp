@@ -0,0 +1,109 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+#include <iostream>
+#include <wsjcpp_sql_builder.h>
+
+struct User {
+  long id;
+  std::string name;
+  double rating;
+  int level;
+};
+
+int main() {
+  wsjcpp::SqlRowMapping<User> mapping("users");
+  mapping
+    .primaryKey("id", &User::id)
+    .colum("name", &User::name)
+    .colum("rating", &User::rating)
+    .colum("level", &User::level)
+  ;
+
+  User before = {1, "user1", 1.5, 10};
+  User after = before;
+  after.level = 11;
+
+  wsjcpp::SqlBuilder builder;
+  if (!builder.updateChanged(mapping, before, after)) {
+    std::cerr << "Expected update statement for changed level" << std::endl;
+    return -1;
+  }
+  if (builder.updateChanged(mapping, before, before)) {
+    std::cerr << "Expected no statement for not changed object" << std::endl;
+    return -1;
+  }
+
+  if (builder.hasErrors()) {
+    std::cerr << "Builder has some errors" << std::endl;
+    return -1;
+  }
+  std::string sqlQuery = builder.sql();
+  std::string sqlQueryExpected = "UPDATE users SET level = 11 WHERE id = 1";
+  if (sqlQuery != sqlQueryExpected) {
+    std::cerr
+      << "Expected:" << std::endl
+      << "   {" << sqlQueryExpected << "}" << std::endl
+      << ", but got:" << std::endl
+      << "   {" << sqlQuery << "}" << std::endl
+    ;
+    return -1;
+  }
+
+  std::string full = "UPDATE users SET name = 'user1', rating = 1.5, level = 10 WHERE id = 1";
+  const wsjcpp::SqlUpdateDeltaStats &stats = builder.updateDeltaStats();
+  if (stats.statements != 1 || stats.statementsSkipped != 1 || stats.columnsSkipped != 5) {
+    std::cerr
+      << "Unexpected stats: statements = " << stats.statements
+      << ", statementsSkipped = " << stats.statementsSkipped
+      << ", columnsSkipped = " << stats.columnsSkipped << std::endl;
+    return -1;
+  }
+  // full update with level = 11 has the same size as 'full'
+  std::size_t bytesSavedExpected = (full.size() - sqlQuery.size()) + full.size();
+  if (stats.bytesSaved != bytesSavedExpected) {
+    std::cerr << "Expected bytesSaved " << bytesSavedExpected << ", but got " << stats.bytesSaved << std::endl;
+    return -1;
+  }
+
+  builder.resetUpdateDeltaStats();
+  if (builder.updateDeltaStats().statements != 0) {
+    std::cerr << "Expected reset stats" << std::endl;
+    return -1;
+  }
+
+  // 'UPDATE users SET  WHERE id = 1' must not be built silently
+  wsjcpp::SqlBuilder notChanged;
+  notChanged.update("users").objectChanges(mapping, before, before);
+  if (!notChanged.hasErrors()) {
+    std::cerr << "Expected error for update without changed fields" << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
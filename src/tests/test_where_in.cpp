@@ -0,0 +1,108 @@
+/**********************************************************************************
+ * MIT License
+ *
+ * Copyright (c) 2025-2026 Evgenii Sopov <mrseakg@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ *all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * Official Source Code: https://github.com/wsjcpp/wsjcpp-sql-builder
+ *
+ ***********************************************************************************/
+
+
+
+#include <iostream>
+#include <set>
+#include <wsjcpp_sql_builder.h>
+#include "test_helpers.h"
+
+int main() {
+  int ret = 0;
+  wsjcpp::SqlBuilder builder;
+
+  std::vector<int> ids = {5, 1, 3, 1, 5};
+  builder.selectFrom("users").colum("name").where().in("id", ids);
+  ret += checkSql("sorted", builder.sql(), "SELECT name FROM users WHERE id IN (1, 3, 5)");
+
+  builder.clear();
+  std::set<std::string> names = {"b", "a'c"};
+  builder.deleteFrom("users").where().notIn("name", names).equal("level", 1);
+  ret += checkSql("not in", builder.sql(), "DELETE FROM users WHERE name NOT IN ('a''c', 'b') AND level = 1");
+
+  builder.clear();
+  builder.selectFrom("users").colum("name").where().in("id", std::vector<long>{4, 3, 2, 1, 5}, 2).equal("level", 1);
+  ret += checkSql(
+    "chunks",
+    builder.sql(),
+    "SELECT name FROM users WHERE (id IN (1, 2) OR id IN (3, 4) OR id IN (5)) AND level = 1"
+  );
+
+  builder.clear();
+  builder.selectFrom("users").colum("name").where().notIn("id", std::vector<long>{3, 2, 1}, 2);
+  ret += checkSql("not in chunks", builder.sql(), "SELECT name FROM users WHERE (id NOT IN (1, 2) AND id NOT IN (3))");
+
+  builder.clear();
+  builder.selectFrom("users").colum("name").where().in("id", std::vector<int>{}).or_().notIn("id", std::vector<int>{});
+  ret += checkSql("empty", builder.sql(), "SELECT name FROM users WHERE 1 = 0 OR 1 = 1");
+
+  // '1 = 0' is other statement than 'id IN (...)'
+  builder.clear();
+  uint64_t fpEmpty = builder.selectFrom("users").colum("name").where().in("id", std::vector<int>{}).endWhere().fingerprint();
+  uint64_t fpValues = builder.selectFrom("users").colum("name").where().in("id", std::vector<int>{1}).endWhere().fingerprint();
+  if (fpEmpty == fpValues) {
+    std::cerr << "Expected other fingerprint for empty list" << std::endl;
+    ret -= 1;
+  }
+
+  // constant shape
+  builder.clear();
+  uint64_t fp1 = builder.selectFrom("users").colum("name").where().inArray("id", std::vector<int>{3, 1}).endWhere().fingerprint();
+  ret += checkSql(
+    "sqlite array",
+    builder.sql(),
+    "SELECT name FROM users WHERE id IN (SELECT value FROM json_each('[1,3]'))"
+  );
+  builder.clear();
+  uint64_t fp2 = builder.selectFrom("users").colum("name").where().inArray("id", std::vector<int>{1, 2, 3, 4}).endWhere().fingerprint();
+  if (fp1 != fp2) {
+    std::cerr << "Expected the same fingerprint for any count of values" << std::endl;
+    ret -= 1;
+  }
+
+  builder.clear();
+  builder.selectFrom("users").colum("id").where().notInArray("name", std::vector<std::string>{"it's", "a\"b"});
+  ret += checkSql(
+    "sqlite strings array",
+    builder.sql(),
+    "SELECT id FROM users WHERE name NOT IN (SELECT value FROM json_each('[\"a\\\"b\",\"it''s\"]'))"
+  );
+
+  wsjcpp::SqlBuilder postgres(wsjcpp::SqlBuilderForDatabase::POSTGRESQL);
+  postgres.selectFrom("users").colum("id").where().inArray("name", std::vector<std::string>{"b", "a,c"});
+  ret += checkSql("postgres array", postgres.sql(), "SELECT id FROM users WHERE name = ANY('{\"a,c\",\"b\"}')");
+  postgres.clear();
+  postgres.selectFrom("users").colum("id").where().notInArray("id", std::vector<int>{2, 1});
+  ret += checkSql("postgres not array", postgres.sql(), "SELECT id FROM users WHERE id <> ALL('{1,2}')");
+
+  wsjcpp::SqlBuilder mysql(wsjcpp::SqlBuilderForDatabase::MYSQL);
+  mysql.selectFrom("users").colum("id").where().notInArray("id", std::vector<int>{2, 1});
+  ret += checkSql("mysql array", mysql.sql(), "SELECT id FROM users WHERE NOT id MEMBER OF('[1,2]')");
+
+  return ret == 0 ? 0 : -1;
+}
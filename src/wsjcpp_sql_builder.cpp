@@ -27,6 +27,11 @@
 
 #include "wsjcpp_sql_builder.h"
 #include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 
 namespace wsjcpp {
@@ -35,9 +40,14 @@ namespace wsjcpp {
 // SqlBuilderHelpers
 
 std::string SqlBuilderHelpers::escapingStringValue(const std::string &sValue) {
-  // escaping simbols NUL (ASCII 0), \n, \r, \, ', ", и Control-Z.
   std::string sResult;
   sResult.reserve(sValue.size() * 2);
+  escapingStringValue(sResult, sValue);
+  return sResult;
+}
+
+void SqlBuilderHelpers::escapingStringValue(std::string &sResult, std::string_view sValue) {
+  // escaping simbols NUL (ASCII 0), \n, \r, \, ', ", и Control-Z.
   sResult.push_back('\'');
   for (int i = 0; i < sValue.size(); i++) {
     char c = sValue[i];
@@ -61,302 +71,1746 @@ std::string SqlBuilderHelpers::escapingStringValue(const std::string &sValue) {
     }
   }
   sResult.push_back('\'');
-  return sResult;
 }
 
+std::string SqlBuilderHelpers::formatValue(const std::string &val) {
+  return SqlBuilderHelpers::escapingStringValue(val);
+}
 
-SqlQuery::SqlQuery(SqlQueryType sqlType, SqlBuilder *builder, const std::string &tableName)
-  : m_sqlType(sqlType), m_builder(builder), m_tableName(tableName) {
+std::string SqlBuilderHelpers::formatValue(const char *val) {
+  return SqlBuilderHelpers::escapingStringValue(val);
+}
 
+std::string SqlBuilderHelpers::formatValue(int val) {
+  return std::to_string(val);
 }
 
-SqlQueryType SqlQuery::sqlType() {
-  return m_sqlType;
+std::string SqlBuilderHelpers::formatValue(long val) {
+  return std::to_string(val);
 }
 
-SqlBuilder &SqlQuery::builder() {
-  return *m_builder;
+std::string SqlBuilderHelpers::formatValue(float val) {
+  return std::to_string(val);
 }
 
-SqlBuilder *SqlQuery::builderRawPtr() {
-  return m_builder;
+std::string SqlBuilderHelpers::formatValue(double val) {
+  return std::to_string(val);
 }
 
-const std::string &SqlQuery::tableName() {
-  return m_tableName;
+void SqlBuilderHelpers::appendNumber(std::string &out, long long val) {
+  char buf[24];
+  auto res = std::to_chars(buf, buf + sizeof(buf), val);
+  out.append(buf, res.ptr - buf);
 }
 
-// ---------------------------------------------------------------------
-// SqlWhereBase
+void SqlBuilderHelpers::appendNumber(std::string &out, unsigned long long val) {
+  char buf[24];
+  auto res = std::to_chars(buf, buf + sizeof(buf), val);
+  out.append(buf, res.ptr - buf);
+}
 
-SqlWhereBase::SqlWhereBase(SqlWhereType type) : m_type(type) {
+void SqlBuilderHelpers::appendNumber(std::string &out, float val) {
+  char buf[32];
+  auto res = std::to_chars(buf, buf + sizeof(buf), val);
+  out.append(buf, res.ptr - buf);
+}
 
-};
+void SqlBuilderHelpers::appendNumber(std::string &out, double val) {
+  // shortest round-trip, "%f" loses small values (1e-7 is 0.000000)
+  char buf[32];
+  auto res = std::to_chars(buf, buf + sizeof(buf), val);
+  out.append(buf, res.ptr - buf);
+}
 
-SqlWhereType SqlWhereBase::type() {
-  return m_type;
+bool SqlBuilderHelpers::likePrefix(const std::string &value, std::string &prefix) {
+  if (value.size() < 3 || value[0] != '\'' || value[value.size() - 1] != '\'') {
+    return false;
+  }
+  std::string pattern = value.substr(1, value.size() - 2);
+  std::size_t pos = pattern.find('%');
+  if (pos == 0 || pos == std::string::npos || pattern.find_first_not_of('%', pos) != std::string::npos) {
+    return false;
+  }
+  prefix = pattern.substr(0, pos);
+  for (char c : prefix) {
+    // '_' is a wildcard, backslash is escape in some databases, only ascii to avoid collation surprises
+    if (c < 0x20 || c > 0x7E || c == '_' || c == '\\' || c == '\'') {
+      return false;
+    }
+  }
+  return true;
 }
 
-// ---------------------------------------------------------------------
-// SqlWhereOr
+bool SqlBuilderHelpers::isValueLiteral(const std::string &val) {
+  if (val == "NULL" || (val.size() >= 2 && val[0] == '\'' && val[val.size() - 1] == '\'')) {
+    return true;
+  }
+  char *end = nullptr;
+  std::strtod(val.c_str(), &end);
+  return !val.empty() && end == val.c_str() + val.size();
+}
 
-SqlWhereOr::SqlWhereOr() : SqlWhereBase(SqlWhereType::LOGICAL_OPERATOR) { }
-std::string SqlWhereOr::sql() { return " OR "; };
+bool SqlBuilderHelpers::isColumnName(const std::string &val) {
+  if (val.empty() || (val[0] >= '0' && val[0] <= '9') || val == "NULL" || val == "TRUE" || val == "FALSE") {
+    return false;
+  }
+  for (char c : val) {
+    bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '.';
+    if (!valid) {
+      return false;
+    }
+  }
+  return true;
+}
 
-// ---------------------------------------------------------------------
-// SqlWhereAnd
+bool SqlBuilderHelpers::differentValues(const std::string &val1, const std::string &val2) {
+  if (val1 == val2) {
+    return false;
+  }
+  if (val1 == "NULL" || val2 == "NULL") {
+    return true;
+  }
+  char *end1 = nullptr;
+  char *end2 = nullptr;
+  double num1 = std::strtod(val1.c_str(), &end1);
+  double num2 = std::strtod(val2.c_str(), &end2);
+  bool numbers = !val1.empty() && !val2.empty()
+    && end1 == val1.c_str() + val1.size()
+    && end2 == val2.c_str() + val2.size();
+  return numbers && num1 != num2;
+}
 
-SqlWhereAnd::SqlWhereAnd() : SqlWhereBase(SqlWhereType::LOGICAL_OPERATOR) { }
-std::string SqlWhereAnd::sql() { return " AND "; };
+void SqlBuilderHelpers::appendJsonString(std::string &out, const std::string &val) {
+  const char hex[] = "0123456789abcdef";
+  out += '"';
+  for (unsigned char c : val) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (c < 0x20) {
+      out += "\\u00";
+      out += hex[c >> 4];
+      out += hex[c & 0xF];
+    } else {
+      out += c;
+    }
+  }
+  out += '"';
+}
 
-// ---------------------------------------------------------------------
-// SqlWhereCondition
+void SqlBuilderHelpers::appendArrayString(std::string &out, const std::string &val) {
+  out += '"';
+  for (char c : val) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+    }
+    out += c;
+  }
+  out += '"';
+}
 
-SqlWhereCondition::SqlWhereCondition(
-  const std::string &name,
-  SqlWhereConditionType comparator,
-  const std::string &value
-) : SqlWhereBase(SqlWhereType::CONDITION), m_name(name), m_comparator(comparator) {
-  // TODO in different databases different quotes, mssql have a column names in double quotes
-  m_value = SqlBuilderHelpers::escapingStringValue(value);
+void SqlBuilderHelpers::appendValue(std::string &out, int val) {
+  appendNumber(out, static_cast<long long>(val));
 }
 
-SqlWhereCondition::SqlWhereCondition(
-  const std::string &name,
-  SqlWhereConditionType comparator,
-  int value
-) : SqlWhereBase(SqlWhereType::CONDITION), m_name(name), m_comparator(comparator) {
-  m_value = std::to_string(value);
+void SqlBuilderHelpers::appendValue(std::string &out, long val) {
+  appendNumber(out, static_cast<long long>(val));
 }
 
-SqlWhereCondition::SqlWhereCondition(
-  const std::string &name,
-  SqlWhereConditionType comparator,
-  long value
-) : SqlWhereBase(SqlWhereType::CONDITION), m_name(name), m_comparator(comparator) {
-  m_value = std::to_string(value);
+void SqlBuilderHelpers::appendValue(std::string &out, float val) {
+  appendValue(out, static_cast<double>(val));
 }
 
-SqlWhereCondition::SqlWhereCondition(
-  const std::string &name,
-  SqlWhereConditionType comparator,
-  double value
-) : SqlWhereBase(SqlWhereType::CONDITION), m_name(name), m_comparator(comparator) {
-  m_value = std::to_string(value);
+void SqlBuilderHelpers::appendValue(std::string &out, double val) {
+  // "%f" as std::to_string() in formatValue()
+  char buf[std::numeric_limits<double>::max_exponent10 + 16];
+  int size = std::snprintf(buf, sizeof(buf), "%f", val);
+  out.append(buf, size);
 }
 
-SqlWhereCondition::SqlWhereCondition(
-  const std::string &name,
-  SqlWhereConditionType comparator,
-  float value
-) : SqlWhereBase(SqlWhereType::CONDITION), m_name(name), m_comparator(comparator) {
-  m_value = std::to_string(value);
+// ---------------------------------------------------------------------
+// SqlDialectSqlite3
+
+std::string SqlDialectSqlite3::quoteIdentifier(const std::string &name) {
+  std::string ret = "\"";
+  for (char c : name) {
+    if (c == '"') {
+      ret += '"';
+    }
+    ret += c;
+  }
+  return ret + "\"";
 }
 
-const std::string &SqlWhereCondition::name() {
-  return m_name;
+std::string SqlDialectSqlite3::escapeString(const std::string &val) {
+  std::string ret;
+  ret.reserve(val.size() + 2);
+  appendEscapedString(ret, val);
+  return ret;
 }
 
-SqlWhereConditionType SqlWhereCondition::comparator() {
-  return m_comparator;
+void SqlDialectSqlite3::appendEscapedString(std::string &out, std::string_view val) {
+  // standard sql: only quote is doubled, backslash has no special meaning
+  out.push_back('\'');
+  for (char c : val) {
+    if (c == '\'') {
+      out.push_back('\'');
+    }
+    out.push_back(c);
+  }
+  out.push_back('\'');
 }
 
-const std::string &SqlWhereCondition::value() {
-  return m_value;
+SqlChunkLimits SqlDialectSqlite3::chunkLimits() {
+  SqlChunkLimits limits;
+  limits.maxBytes = 1000000; // SQLITE_MAX_SQL_LENGTH
+  limits.maxVariables = 32766; // SQLITE_MAX_VARIABLE_NUMBER since 3.32.0
+  return limits;
 }
 
-std::string SqlWhereCondition::sql() {
-  std::string ret;
-  ret += m_name; // TODO validate and escaping
-  switch (m_comparator) {
-    case SqlWhereConditionType::NOT_EQUAL:
-      ret += " <> ";
-      break;
-    case SqlWhereConditionType::EQUAL:
-      ret += " = ";
-      break;
-    case SqlWhereConditionType::MORE_THEN:
-      ret += " > ";
-      break;
-    case SqlWhereConditionType::LESS_THEN:
-      ret += " < ";
-      break;
-    case SqlWhereConditionType::LIKE:
-      ret += " LIKE ";
-      break;
-    default:
-      ret += " unknwon_operator ";
-      break;
+std::string SqlDialectSqlite3::limitOffset(long limit, long offset) {
+  if (limit < 0 && offset <= 0) {
+    return "";
+  }
+  std::string ret = " LIMIT " + std::to_string(limit < 0 ? -1 : limit);
+  if (offset > 0) {
+    ret += " OFFSET " + std::to_string(offset);
   }
-  ret += m_value;
   return ret;
 }
 
-// ---------------------------------------------------------------------
-// SqlSelect
+std::string SqlDialectSqlite3::beginTransaction() {
+  return "BEGIN";
+}
 
-SqlSelect::SqlSelect(const std::string &tableName, SqlBuilder *builder)
-: SqlQuery(SqlQueryType::SELECT, builder, tableName) {
-  // TODO multitype table names with AS
+std::string SqlDialectSqlite3::commitTransaction() {
+  return "COMMIT";
 }
 
-SqlSelect &SqlSelect::colum(const std::string &col, const std::string &col_as) {
-  auto it = std::find(m_columns.begin(), m_columns.end(), col);
-  if (it != m_columns.end()) {
-    builder().addError("Column '" + col + "' already added to select");
-  } else {
-    m_columns.push_back(col);
-    m_columns_as[col] = col_as;
-  }
-  return *this;
+bool SqlDialectSqlite3::rowValueComparison() {
+  // since 3.15.0
+  return true;
 }
 
-SqlWhere<SqlSelect> &SqlSelect::where() {
-  if (!m_where) {
-    m_where = std::make_shared<SqlWhere<SqlSelect>>(nullptr, builderRawPtr(), this);
+bool SqlDialectSqlite3::conflictTargetRequired() {
+  return true;
+}
+
+bool SqlDialectSqlite3::batchUpdateFromValues() {
+  // UPDATE ... FROM only since 3.33.0
+  return false;
+}
+
+bool SqlDialectSqlite3::supportsReturning() {
+  // since 3.35.0
+  return true;
+}
+
+bool SqlDialectSqlite3::insertSelectNeedsWhere() {
+  // ON CONFLICT after select without where looks like a join constraint
+  return true;
+}
+
+std::string SqlDialectSqlite3::arrayLiteral(const std::vector<std::string> &items, bool strings) {
+  // JSON array
+  std::string ret = "[";
+  for (std::size_t i = 0; i < items.size(); i++) {
+    if (i > 0) {
+      ret += ",";
+    }
+    if (strings) {
+      SqlBuilderHelpers::appendJsonString(ret, items[i]);
+    } else {
+      ret += items[i];
+    }
   }
-  return *(m_where.get());
+  return ret + "]";
 }
 
-std::string SqlSelect::sql() {
-  std::string ret = "SELECT ";
-  // TODO TOP OR LIMIT for different databases
+std::string SqlDialectSqlite3::inArray(const std::string &name, bool notIn, const std::string &array) {
+  return name + (notIn ? " NOT IN" : " IN") + " (SELECT value FROM json_each(" + array + "))";
+}
 
-  if (m_columns.size() == 0) {
-    ret += "*";
-  } else {
+bool SqlDialectSqlite3::supportsCopy() {
+  return false;
+}
+
+bool SqlDialectSqlite3::likePrefixRange() {
+  return true;
+}
+
+std::string SqlDialectSqlite3::upsertClause(
+  const std::vector<std::string> &conflictColumns,
+  const std::vector<std::string> &/*insertColumns*/,
+  const std::vector<std::string> &updateColumns
+) {
+  std::string ret = " ON CONFLICT";
+  if (conflictColumns.size() > 0) {
+    ret += "(";
     bool first = true;
-    for (auto col : m_columns) {
+    for (auto col : conflictColumns) {
       if (!first) {
         ret += ", ";
       }
       ret += col;
-      if (m_columns_as[col] != "") {
-        ret += " AS " + m_columns_as[col];
-      }
       first = false;
     }
-    ret += " FROM ";
-    ret += tableName();
+    ret += ")";
   }
-
-  if (m_where) {
-    ret += " WHERE " + m_where->sql();
+  if (updateColumns.size() == 0) {
+    return ret + " DO NOTHING";
+  }
+  ret += " DO UPDATE SET ";
+  bool first = true;
+  for (auto col : updateColumns) {
+    if (!first) {
+      ret += ", ";
+    }
+    ret += col + " = excluded." + col;
+    first = false;
   }
-
-  // TODO group by
-  // TODO order by
   return ret;
 }
 
 // ---------------------------------------------------------------------
-// SqlInsert
+// SqlDialectPostgreSQL
 
-SqlInsert::SqlInsert(const std::string &tableName, SqlBuilder *builder)
-: SqlQuery(SqlQueryType::INSERT, builder, tableName) {
+std::string SqlDialectPostgreSQL::quoteIdentifier(const std::string &name) {
+  return SqlDialectSqlite3::quoteIdentifier(name);
+}
 
+std::string SqlDialectPostgreSQL::escapeString(const std::string &val) {
+  // with standard_conforming_strings (default since 9.1)
+  return SqlDialectSqlite3::escapeString(val);
 }
 
-SqlInsert &SqlInsert::colum(const std::string &col) {
-  m_columns.push_back(col);
-  return *this;
+void SqlDialectPostgreSQL::appendEscapedString(std::string &out, std::string_view val) {
+  SqlDialectSqlite3::appendEscapedString(out, val);
 }
 
-SqlInsert &SqlInsert::addColums(const std::vector<std::string> &cols) {
-  for (auto col : cols) {
-    m_columns.push_back(col);
+SqlChunkLimits SqlDialectPostgreSQL::chunkLimits() {
+  SqlChunkLimits limits;
+  limits.maxVariables = 65535; // bind parameters in the protocol
+  return limits;
+}
+
+std::string SqlDialectPostgreSQL::limitOffset(long limit, long offset) {
+  std::string ret;
+  if (limit >= 0) {
+    ret += " LIMIT " + std::to_string(limit);
   }
-  return *this;
+  if (offset > 0) {
+    ret += " OFFSET " + std::to_string(offset);
+  }
+  return ret;
 }
 
-SqlInsert &SqlInsert::clearValues() {
-  m_values.clear();
-  return *this;
+std::string SqlDialectPostgreSQL::beginTransaction() {
+  return "BEGIN";
 }
 
-SqlInsert &SqlInsert::val(const std::string &val) {
-  m_values.push_back(SqlBuilderHelpers::escapingStringValue(val));
-  return *this;
+std::string SqlDialectPostgreSQL::commitTransaction() {
+  return "COMMIT";
 }
 
-SqlInsert &SqlInsert::val(int val) {
-  m_values.push_back(std::to_string(val));
-  return *this;
+bool SqlDialectPostgreSQL::rowValueComparison() {
+  return true;
 }
 
-SqlInsert &SqlInsert::val(long val) {
-  m_values.push_back(std::to_string(val));
-  return *this;
+bool SqlDialectPostgreSQL::conflictTargetRequired() {
+  return true;
 }
 
-SqlInsert &SqlInsert::val(float val) {
-  m_values.push_back(std::to_string(val));
-  return *this;
+bool SqlDialectPostgreSQL::batchUpdateFromValues() {
+  return true;
 }
 
-SqlInsert &SqlInsert::val(double val) {
-  m_values.push_back(std::to_string(val));
-  return *this;
+bool SqlDialectPostgreSQL::supportsReturning() {
+  return true;
 }
 
-std::string SqlInsert::sql() {
-  std::string ret = "INSERT INTO " + tableName();
+bool SqlDialectPostgreSQL::insertSelectNeedsWhere() {
+  return false;
+}
 
-  // TODO if columns is empty
-  ret += "(";
-  bool first = true;
-  for (auto col : m_columns) {
-    if (!first) {
-      ret += ", ";
+std::string SqlDialectPostgreSQL::arrayLiteral(const std::vector<std::string> &items, bool strings) {
+  std::string ret = "{";
+  for (std::size_t i = 0; i < items.size(); i++) {
+    if (i > 0) {
+      ret += ",";
     }
-    ret += col;
-    first = false;
-  }
-  ret += ")";
-
-  ret += " VALUES(";
-  first = true;
-  for (auto val : m_values) {
-    if (!first) {
-      ret += ", ";
+    if (strings) {
+      SqlBuilderHelpers::appendArrayString(ret, items[i]);
+    } else {
+      ret += items[i];
     }
-    ret += val;
-    first = false;
   }
-  ret += ")";
+  return ret + "}";
+}
 
-  return ret;
-};
+std::string SqlDialectPostgreSQL::inArray(const std::string &name, bool notIn, const std::string &array) {
+  return name + (notIn ? " <> ALL(" : " = ANY(") + array + ")";
+}
+
+bool SqlDialectPostgreSQL::supportsCopy() {
+  return true;
+}
+
+bool SqlDialectPostgreSQL::likePrefixRange() {
+  return true;
+}
+
+std::string SqlDialectPostgreSQL::upsertClause(
+  const std::vector<std::string> &conflictColumns,
+  const std::vector<std::string> &insertColumns,
+  const std::vector<std::string> &updateColumns
+) {
+  return SqlDialectSqlite3::upsertClause(conflictColumns, insertColumns, updateColumns);
+}
 
 // ---------------------------------------------------------------------
-// SqlUpdate
+// SqlDialectMySQL
 
-SqlUpdate::SqlUpdate(const std::string &tableName, SqlBuilder *builder)
-  : SqlQuery(SqlQueryType::UPDATE, builder, tableName) {
+std::string SqlDialectMySQL::quoteIdentifier(const std::string &name) {
+  std::string ret = "`";
+  for (char c : name) {
+    if (c == '`') {
+      ret += '`';
+    }
+    ret += c;
+  }
+  return ret + "`";
+}
 
+std::string SqlDialectMySQL::escapeString(const std::string &val) {
+  // backslash is an escape character in mysql by default
+  return SqlBuilderHelpers::escapingStringValue(val);
 }
 
-SqlUpdate &SqlUpdate::set(const std::string &name, const std::string &val) {
-  return setValue(name, SqlBuilderHelpers::escapingStringValue(val));
+void SqlDialectMySQL::appendEscapedString(std::string &out, std::string_view val) {
+  SqlBuilderHelpers::escapingStringValue(out, val);
 }
 
-SqlUpdate &SqlUpdate::set(const std::string &name, int val) {
-  return setValue(name, std::to_string(val));
+SqlChunkLimits SqlDialectMySQL::chunkLimits() {
+  SqlChunkLimits limits;
+  limits.maxBytes = 67108864; // default max_allowed_packet
+  limits.maxVariables = 65535; // placeholders in prepared statement
+  return limits;
 }
 
-SqlUpdate &SqlUpdate::set(const std::string &name, long val) {
-  return setValue(name, std::to_string(val));
+std::string SqlDialectMySQL::limitOffset(long limit, long offset) {
+  if (limit < 0 && offset <= 0) {
+    return "";
+  }
+  std::string ret = " LIMIT ";
+  if (offset > 0) {
+    ret += std::to_string(offset) + ", ";
+  }
+  // mysql has no syntax for offset without limit
+  ret += limit < 0 ? "18446744073709551615" : std::to_string(limit);
+  return ret;
 }
 
-SqlUpdate &SqlUpdate::set(const std::string &name, float val) {
-  return setValue(name, std::to_string(val));
+std::string SqlDialectMySQL::beginTransaction() {
+  return "START TRANSACTION";
 }
 
-SqlUpdate &SqlUpdate::set(const std::string &name, double val) {
-  return setValue(name, std::to_string(val));
+std::string SqlDialectMySQL::commitTransaction() {
+  return "COMMIT";
 }
 
-SqlUpdate &SqlUpdate::setValue(const std::string &name, const std::string &val) {
+bool SqlDialectMySQL::rowValueComparison() {
+  // supported, but range access by index is not used for row constructors
+  return false;
+}
+
+bool SqlDialectMySQL::conflictTargetRequired() {
+  // conflict target is not used, any unique key
+  return false;
+}
+
+bool SqlDialectMySQL::batchUpdateFromValues() {
+  // no UPDATE ... FROM, only multi-table update with join
+  return false;
+}
+
+bool SqlDialectMySQL::supportsReturning() {
+  return false;
+}
+
+bool SqlDialectMySQL::insertSelectNeedsWhere() {
+  return false;
+}
+
+std::string SqlDialectMySQL::arrayLiteral(const std::vector<std::string> &items, bool strings) {
+  return SqlDialectSqlite3::arrayLiteral(items, strings);
+}
+
+std::string SqlDialectMySQL::inArray(const std::string &name, bool notIn, const std::string &array) {
+  return (notIn ? "NOT " : "") + name + " MEMBER OF(" + array + ")";
+}
+
+bool SqlDialectMySQL::supportsCopy() {
+  return false;
+}
+
+bool SqlDialectMySQL::likePrefixRange() {
+  // already uses index range for prefix LIKE
+  return false;
+}
+
+std::string SqlDialectMySQL::upsertClause(
+  const std::vector<std::string> &conflictColumns,
+  const std::vector<std::string> &insertColumns,
+  const std::vector<std::string> &updateColumns
+) {
+  std::string ret = " ON DUPLICATE KEY UPDATE ";
+  if (updateColumns.size() == 0) {
+    // do nothing, without INSERT IGNORE which ignores also other errors
+    if (conflictColumns.size() == 0 && insertColumns.size() == 0) {
+      return "";
+    }
+    std::string col = conflictColumns.size() > 0 ? conflictColumns[0] : insertColumns[0];
+    return ret + col + " = " + col;
+  }
+  bool first = true;
+  for (auto col : updateColumns) {
+    if (!first) {
+      ret += ", ";
+    }
+    ret += col + " = VALUES(" + col + ")";
+    first = false;
+  }
+  return ret;
+}
+
+// ---------------------------------------------------------------------
+// ISqlDialect
+
+std::string ISqlDialect::identifier(const std::string &name) const {
+  // reserved in all supported databases and likely to be a column name
+  static const std::vector<std::string> reserved = {
+    "all", "and", "as", "by", "case", "check", "column", "default", "desc", "distinct", "from",
+    "group", "in", "index", "key", "limit", "not", "null", "or", "order", "primary", "references",
+    "select", "table", "to", "union", "unique", "user", "values", "when", "where",
+  };
+  if (!SqlBuilderHelpers::isColumnName(name) || name.find('.') != std::string::npos) {
+    return name; // expression, table.name or already quoted
+  }
+  std::string lower = name;
+  for (char &c : lower) {
+    c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+  }
+  if (std::find(reserved.begin(), reserved.end(), lower) == reserved.end()) {
+    return name;
+  }
+  return quoteIdentifier(name);
+}
+
+// ---------------------------------------------------------------------
+// SqlLiteral
+
+SqlLiteral::SqlLiteral(const std::string &sql) : m_sql(sql) {
+
+}
+
+SqlLiteral SqlLiteral::null() {
+  return SqlLiteral("NULL");
+}
+
+const std::string &SqlLiteral::sql() const {
+  return m_sql;
+}
+
+bool SqlLiteral::isNull() const {
+  return m_sql == "NULL";
+}
+
+// ---------------------------------------------------------------------
+// SqlQuery
+
+SqlQuery::SqlQuery(SqlQueryType sqlType, SqlBuilder *builder, const std::string &tableName)
+  : m_sqlType(sqlType), m_builder(builder), m_tableName(tableName) {
+  m_fingerprint = 14695981039346656037ULL; // FNV-1a 64 offset basis
+  mixFingerprint(SqlFingerprintToken::QUERY_TYPE, std::to_string(static_cast<int>(sqlType)));
+  mixFingerprint(SqlFingerprintToken::TABLE, tableName);
+}
+
+SqlQueryType SqlQuery::sqlType() {
+  return m_sqlType;
+}
+
+SqlBuilder &SqlQuery::builder() {
+  return *m_builder;
+}
+
+SqlBuilder *SqlQuery::builderRawPtr() {
+  return m_builder;
+}
+
+const std::string &SqlQuery::tableName() {
+  return m_tableName;
+}
+
+void SqlQuery::addError(const std::string &err) {
+  m_builder->addError(err);
+}
+
+const ISqlDialect &SqlQuery::dialect() const {
+  return m_builder->dialect();
+}
+
+std::vector<std::string> SqlQuery::statements() {
+  return {sql()};
+}
+
+uint64_t SqlQuery::fingerprint() const {
+  return m_fingerprint;
+}
+
+bool SqlQuery::hasReturning() const {
+  return m_returning.size() > 0;
+}
+
+void SqlQuery::addReturning(const std::vector<std::string> &cols) {
+  if (!dialect().supportsReturning()) {
+    addError("RETURNING is not supported by the database, query for '" + tableName() + "'");
+    return;
+  }
+  for (auto col : cols) {
+    if (std::find(m_returning.begin(), m_returning.end(), col) == m_returning.end()) {
+      m_returning.push_back(col);
+      mixFingerprint(SqlFingerprintToken::RETURNING, col);
+    }
+  }
+}
+
+bool SqlQuery::hasWith() const {
+  return m_with.size() > 0;
+}
+
+bool SqlQuery::hasTable(const std::string &tableName) const {
+  return m_tableName == tableName;
+}
+
+void SqlQuery::addWith(const std::string &name, SqlQuery &query) {
+  for (auto with : m_with) {
+    if (with.first == name) {
+      addError("CTE '" + name + "' already added to query for '" + tableName() + "'");
+      return;
+    }
+  }
+  m_with.push_back(std::make_pair(name, query.sql()));
+  mixFingerprint(SqlFingerprintToken::WITH, name + " " + std::to_string(query.fingerprint()));
+}
+
+std::string SqlQuery::withClause() {
+  if (m_with.size() == 0) {
+    return "";
+  }
+  std::string ret = "WITH ";
+  for (std::size_t i = 0; i < m_with.size(); i++) {
+    if (i > 0) {
+      ret += ", ";
+    }
+    ret += m_with[i].first + " AS (" + m_with[i].second + ")";
+  }
+  return ret + " ";
+}
+
+std::string SqlQuery::returningClause() {
+  if (m_returning.size() == 0) {
+    return "";
+  }
+  std::string ret = " RETURNING ";
+  bool first = true;
+  for (auto col : m_returning) {
+    if (!first) {
+      ret += ", ";
+    }
+    ret += col;
+    first = false;
+  }
+  return ret;
+}
+
+void SqlQuery::mixFingerprint(SqlFingerprintToken token, const std::string &value, int depth) {
+  const uint64_t prime = 1099511628211ULL; // FNV-1a 64 prime
+  m_fingerprint = (m_fingerprint ^ static_cast<uint8_t>(token)) * prime;
+  m_fingerprint = (m_fingerprint ^ static_cast<uint8_t>(depth)) * prime;
+  for (unsigned char c : value) {
+    m_fingerprint = (m_fingerprint ^ c) * prime;
+  }
+  // separator, so that adjacent tokens can not be confused
+  m_fingerprint = (m_fingerprint ^ 0xFF) * prime;
+}
+
+// ---------------------------------------------------------------------
+// SqlWhereBase
+
+SqlWhereBase::SqlWhereBase(SqlWhereType type) : m_type(type) {
+
+};
+
+SqlWhereType SqlWhereBase::type() {
+  return m_type;
+}
+
+void SqlWhereBase::columns([[maybe_unused]] std::vector<std::string> &names) {
+  // logical operators have no columns
+}
+
+bool SqlWhereBase::hasSubqueries() {
+  return false;
+}
+
+// ---------------------------------------------------------------------
+// SqlWhereOr
+
+SqlWhereOr::SqlWhereOr() : SqlWhereBase(SqlWhereType::LOGICAL_OPERATOR) { }
+std::string SqlWhereOr::sql() { return " OR "; };
+
+// ---------------------------------------------------------------------
+// SqlWhereAnd
+
+SqlWhereAnd::SqlWhereAnd() : SqlWhereBase(SqlWhereType::LOGICAL_OPERATOR) { }
+std::string SqlWhereAnd::sql() { return " AND "; };
+
+// ---------------------------------------------------------------------
+// SqlWhereCondition
+
+SqlWhereCondition::SqlWhereCondition(
+  const std::string &name,
+  SqlWhereConditionType comparator,
+  const SqlLiteral &value
+) : SqlWhereBase(SqlWhereType::CONDITION), m_name(name), m_comparator(comparator) {
+  m_value = value.sql();
+}
+
+SqlWhereCondition::SqlWhereCondition(
+  const std::string &name,
+  SqlWhereConditionType comparator,
+  const SqlLiteral &value,
+  const ISqlDialect &dialect
+) : SqlWhereBase(SqlWhereType::CONDITION), m_name(name), m_comparator(comparator), m_dialect(&dialect) {
+  m_value = value.sql();
+}
+
+SqlWhereCondition::SqlWhereCondition(
+  const std::string &name,
+  SqlWhereConditionType comparator,
+  const std::string &value
+) : SqlWhereBase(SqlWhereType::CONDITION), m_name(name), m_comparator(comparator) {
+  m_value = SqlBuilderHelpers::escapingStringValue(value);
+}
+
+SqlWhereCondition::SqlWhereCondition(
+  const std::string &name,
+  SqlWhereConditionType comparator,
+  int value
+) : SqlWhereBase(SqlWhereType::CONDITION), m_name(name), m_comparator(comparator) {
+  m_value = std::to_string(value);
+}
+
+SqlWhereCondition::SqlWhereCondition(
+  const std::string &name,
+  SqlWhereConditionType comparator,
+  long value
+) : SqlWhereBase(SqlWhereType::CONDITION), m_name(name), m_comparator(comparator) {
+  m_value = std::to_string(value);
+}
+
+SqlWhereCondition::SqlWhereCondition(
+  const std::string &name,
+  SqlWhereConditionType comparator,
+  double value
+) : SqlWhereBase(SqlWhereType::CONDITION), m_name(name), m_comparator(comparator) {
+  m_value = std::to_string(value);
+}
+
+SqlWhereCondition::SqlWhereCondition(
+  const std::string &name,
+  SqlWhereConditionType comparator,
+  float value
+) : SqlWhereBase(SqlWhereType::CONDITION), m_name(name), m_comparator(comparator) {
+  m_value = std::to_string(value);
+}
+
+const std::string &SqlWhereCondition::name() {
+  return m_name;
+}
+
+SqlWhereConditionType SqlWhereCondition::comparator() {
+  return m_comparator;
+}
+
+const std::string &SqlWhereCondition::value() {
+  return m_value;
+}
+
+void SqlWhereCondition::setSubquery(bool subquery) {
+  m_subquery = subquery;
+}
+
+bool SqlWhereCondition::hasSubqueries() {
+  return m_subquery;
+}
+
+void SqlWhereCondition::setListSize(std::size_t size) {
+  m_listSize = size;
+}
+
+std::size_t SqlWhereCondition::listSize() {
+  return m_listSize;
+}
+
+void SqlWhereCondition::columns(std::vector<std::string> &names) {
+  if (m_name != "") {
+    names.push_back(m_name);
+  }
+}
+
+std::string SqlWhereCondition::sql() {
+  std::string ret;
+  ret += m_name; // TODO validate and escaping
+  if (m_value == "NULL" && m_comparator == SqlWhereConditionType::EQUAL) {
+    return ret + " IS NULL";
+  }
+  if (m_value == "NULL" && m_comparator == SqlWhereConditionType::NOT_EQUAL) {
+    return ret + " IS NOT NULL";
+  }
+  if (m_comparator == SqlWhereConditionType::EXISTS) {
+    return "EXISTS " + m_value;
+  }
+  if (m_comparator == SqlWhereConditionType::NOT_EXISTS) {
+    return "NOT EXISTS " + m_value;
+  }
+  if (m_value == "()" && m_comparator == SqlWhereConditionType::IN) {
+    return "1 = 0"; // nothing can be found by empty list
+  }
+  if (m_value == "()" && m_comparator == SqlWhereConditionType::NOT_IN) {
+    return "1 = 1";
+  }
+  if (m_comparator == SqlWhereConditionType::IN_ARRAY || m_comparator == SqlWhereConditionType::NOT_IN_ARRAY) {
+    const ISqlDialect &dialect = m_dialect != nullptr ? *m_dialect : SqlDialect<SqlDialectSqlite3>::instance();
+    return dialect.inArray(ret, m_comparator == SqlWhereConditionType::NOT_IN_ARRAY, m_value);
+  }
+  switch (m_comparator) {
+    case SqlWhereConditionType::NOT_EQUAL:
+      ret += " <> ";
+      break;
+    case SqlWhereConditionType::EQUAL:
+      ret += " = ";
+      break;
+    case SqlWhereConditionType::MORE_THEN:
+      ret += " > ";
+      break;
+    case SqlWhereConditionType::LESS_THEN:
+      ret += " < ";
+      break;
+    case SqlWhereConditionType::MORE_OR_EQUAL:
+      ret += " >= ";
+      break;
+    case SqlWhereConditionType::LESS_OR_EQUAL:
+      ret += " <= ";
+      break;
+    case SqlWhereConditionType::LIKE:
+      ret += " LIKE ";
+      break;
+    case SqlWhereConditionType::IN:
+      ret += " IN ";
+      break;
+    case SqlWhereConditionType::NOT_IN:
+      ret += " NOT IN ";
+      break;
+    default:
+      ret += " unknwon_operator ";
+      break;
+  }
+  ret += m_value;
+  return ret;
+}
+
+// ---------------------------------------------------------------------
+// SqlKeysetCursor
+
+SqlKeysetCursor &SqlKeysetCursor::val(int value) {
+  return val(static_cast<long long>(value));
+}
+
+SqlKeysetCursor &SqlKeysetCursor::val(long value) {
+  return val(static_cast<long long>(value));
+}
+
+SqlKeysetCursor &SqlKeysetCursor::val(long long value) {
+  m_types.push_back('i');
+  m_values.push_back(std::to_string(value));
+  return *this;
+}
+
+SqlKeysetCursor &SqlKeysetCursor::val(float value) {
+  return val(static_cast<double>(value));
+}
+
+SqlKeysetCursor &SqlKeysetCursor::val(double value) {
+  // exact value, the next page must not skip or repeat rows
+  char buf[32];
+  std::snprintf(buf, sizeof(buf), "%.17g", value);
+  m_types.push_back('r');
+  m_values.push_back(buf);
+  return *this;
+}
+
+SqlKeysetCursor &SqlKeysetCursor::val(const std::string &value) {
+  m_types.push_back('t');
+  m_values.push_back(value);
+  return *this;
+}
+
+SqlKeysetCursor &SqlKeysetCursor::val(const char *value) {
+  return val(std::string(value));
+}
+
+std::size_t SqlKeysetCursor::size() const {
+  return m_values.size();
+}
+
+bool SqlKeysetCursor::isEmpty() const {
+  return m_values.empty();
+}
+
+SqlLiteral SqlKeysetCursor::literal(std::size_t i, const ISqlDialect &dialect) const {
+  if (m_types[i] == 't') {
+    return SqlLiteral(dialect.escapeString(m_values[i]));
+  }
+  return SqlLiteral(m_values[i]);
+}
+
+std::string SqlKeysetCursor::token() const {
+  // <type><length>:<value>... as hex
+  std::string data;
+  for (std::size_t i = 0; i < m_values.size(); i++) {
+    data += m_types[i];
+    data += std::to_string(m_values[i].size()) + ":" + m_values[i];
+  }
+  const char hex[] = "0123456789abcdef";
+  std::string ret;
+  ret.reserve(data.size() * 2);
+  for (unsigned char c : data) {
+    ret += hex[c >> 4];
+    ret += hex[c & 0xF];
+  }
+  return ret;
+}
+
+static int hexDigit(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  return -1;
+}
+
+bool SqlKeysetCursor::parse(const std::string &token) {
+  m_types.clear();
+  m_values.clear();
+  if (token.size() % 2 != 0) {
+    return false;
+  }
+  std::string data;
+  for (std::size_t i = 0; i < token.size(); i += 2) {
+    int hi = hexDigit(token[i]);
+    int lo = hexDigit(token[i + 1]);
+    if (hi < 0 || lo < 0) {
+      return false;
+    }
+    data += static_cast<char>(hi * 16 + lo);
+  }
+
+  std::size_t pos = 0;
+  while (pos < data.size()) {
+    char type = data[pos++];
+    std::size_t sep = data.find(':', pos);
+    // separator is checked before the length is read up to it
+    bool valid = (type == 'i' || type == 'r' || type == 't') && sep != std::string::npos && sep > pos;
+    std::size_t len = 0;
+    if (valid) {
+      auto res = std::from_chars(data.data() + pos, data.data() + sep, len);
+      valid = res.ec == std::errc() && res.ptr == data.data() + sep && len <= data.size() - sep - 1;
+    }
+    if (!valid) {
+      m_types.clear();
+      m_values.clear();
+      return false;
+    }
+    std::string value = data.substr(sep + 1, len);
+    pos = sep + 1 + len;
+
+    // numbers are not escaped, so only numbers are accepted
+    if (type == 'i') {
+      long long number = 0;
+      auto num = std::from_chars(value.data(), value.data() + value.size(), number);
+      valid = !value.empty() && num.ec == std::errc() && num.ptr == value.data() + value.size();
+    } else if (type == 'r') {
+      char *end = nullptr;
+      std::strtod(value.c_str(), &end);
+      valid = !value.empty() && end == value.c_str() + value.size()
+        && value.find_first_not_of("0123456789.eE+-") == std::string::npos;
+    }
+    if (!valid) {
+      m_types.clear();
+      m_values.clear();
+      return false;
+    }
+    m_types.push_back(type);
+    m_values.push_back(value);
+  }
+  return true;
+}
+
+// ---------------------------------------------------------------------
+// SqlSelect
+
+SqlSelect::SqlSelect(const std::string &tableName, SqlBuilder *builder)
+: SqlQuery(SqlQueryType::SELECT, builder, tableName) {
+  m_keysetDescending = false;
+  m_limit = -1;
+  m_offset = -1;
+}
+
+SqlSelect &SqlSelect::with(const std::string &name, SqlQuery &select) {
+  addWith(name, select);
+  return *this;
+}
+
+SqlSelect &SqlSelect::as(const std::string &alias) {
+  m_alias = alias;
+  mixFingerprint(SqlFingerprintToken::COLUMN_AS, alias);
+  return *this;
+}
+
+SqlWhere<SqlSelect> &SqlSelect::innerJoin(const std::string &tableName, const std::string &alias) {
+  return join(SqlJoinType::INNER, tableName, alias);
+}
+
+SqlWhere<SqlSelect> &SqlSelect::leftJoin(const std::string &tableName, const std::string &alias) {
+  return join(SqlJoinType::LEFT, tableName, alias);
+}
+
+SqlWhere<SqlSelect> &SqlSelect::join(SqlJoinType type, const std::string &tableName, const std::string &alias) {
+  SqlSelectJoin join;
+  join.type = type;
+  join.tableName = tableName;
+  join.alias = alias;
+  join.on = std::make_shared<SqlWhere<SqlSelect>>(nullptr, builderRawPtr(), this);
+  m_joins.push_back(join);
+  mixFingerprint(
+    SqlFingerprintToken::JOIN,
+    std::to_string(static_cast<int>(type)) + " " + tableName + " " + alias
+  );
+  return *(join.on.get());
+}
+
+SqlSelect &SqlSelect::colum(const std::string &col, const std::string &col_as) {
+  auto it = std::find(m_columns.begin(), m_columns.end(), col);
+  if (it != m_columns.end()) {
+    builder().addError("Column '" + col + "' already added to select");
+  } else {
+    m_columns.push_back(col);
+    m_columns_as[col] = col_as;
+    mixFingerprint(SqlFingerprintToken::COLUMN, col);
+    if (col_as != "") {
+      mixFingerprint(SqlFingerprintToken::COLUMN_AS, col_as);
+    }
+  }
+  return *this;
+}
+
+SqlSelect &SqlSelect::count(const std::string &col, const std::string &col_as) {
+  return colum("COUNT(" + col + ")", col_as);
+}
+
+SqlSelect &SqlSelect::sum(const std::string &col, const std::string &col_as) {
+  return colum("SUM(" + col + ")", col_as);
+}
+
+SqlSelect &SqlSelect::min(const std::string &col, const std::string &col_as) {
+  return colum("MIN(" + col + ")", col_as);
+}
+
+SqlSelect &SqlSelect::max(const std::string &col, const std::string &col_as) {
+  return colum("MAX(" + col + ")", col_as);
+}
+
+SqlSelect &SqlSelect::avg(const std::string &col, const std::string &col_as) {
+  return colum("AVG(" + col + ")", col_as);
+}
+
+SqlWhere<SqlSelect> &SqlSelect::where() {
+  if (!m_where) {
+    m_where = std::make_shared<SqlWhere<SqlSelect>>(nullptr, builderRawPtr(), this);
+    mixFingerprint(SqlFingerprintToken::WHERE);
+  }
+  return *(m_where.get());
+}
+
+SqlSelect &SqlSelect::groupBy(const std::string &col) {
+  m_groupBy.push_back(col);
+  mixFingerprint(SqlFingerprintToken::GROUP_BY, col);
+  return *this;
+}
+
+SqlWhere<SqlSelect> &SqlSelect::having() {
+  if (!m_having) {
+    m_having = std::make_shared<SqlWhere<SqlSelect>>(nullptr, builderRawPtr(), this);
+    mixFingerprint(SqlFingerprintToken::HAVING);
+  }
+  return *(m_having.get());
+}
+
+SqlSelect &SqlSelect::orderBy(const std::string &col, bool descending) {
+  m_orderBy.push_back(std::make_pair(col, descending));
+  mixFingerprint(SqlFingerprintToken::ORDER_BY, col + (descending ? " DESC" : ""));
+  return *this;
+}
+
+SqlSelect &SqlSelect::limit(long limit) {
+  m_limit = limit;
+  // value is not a part of shape, but presence is
+  mixFingerprint(SqlFingerprintToken::LIMIT);
+  return *this;
+}
+
+SqlSelect &SqlSelect::offset(long offset) {
+  m_offset = offset;
+  mixFingerprint(SqlFingerprintToken::OFFSET);
+  return *this;
+}
+
+SqlSelect &SqlSelect::keyset(
+  const std::vector<std::string> &keyColumns,
+  long pageSize,
+  const SqlKeysetCursor &after,
+  bool descending
+) {
+  if (keyColumns.size() == 0) {
+    addError("SqlSelect. Expected key columns for keyset of '" + tableName() + "'");
+    return *this;
+  }
+  if (!after.isEmpty() && after.size() != keyColumns.size()) {
+    addError("SqlSelect. Cursor has " + std::to_string(after.size()) + " values, but expected "
+      + std::to_string(keyColumns.size()) + " for keyset of '" + tableName() + "'");
+    return *this;
+  }
+  m_keysetColumns = keyColumns;
+  m_keysetDescending = descending;
+  m_limit = pageSize;
+  m_keysetValues.clear();
+  for (std::size_t i = 0; i < after.size(); i++) {
+    m_keysetValues.push_back(after.literal(i, dialect()));
+  }
+
+  std::string shape = descending ? "DESC" : "ASC";
+  for (auto col : keyColumns) {
+    shape += " " + col;
+  }
+  // the first page has no seek condition
+  shape += after.isEmpty() ? " FIRST" : " AFTER";
+  mixFingerprint(SqlFingerprintToken::KEYSET, shape);
+  return *this;
+}
+
+SqlSelect &SqlSelect::keyset(
+  const std::vector<std::string> &keyColumns,
+  long pageSize,
+  const std::string &afterToken,
+  bool descending
+) {
+  SqlKeysetCursor after;
+  if (!after.parse(afterToken)) {
+    addError("SqlSelect. Malformed keyset cursor for '" + tableName() + "'");
+    return *this;
+  }
+  return keyset(keyColumns, pageSize, after, descending);
+}
+
+std::string SqlSelect::keysetCondition() {
+  std::string cmp = m_keysetDescending ? " < " : " > ";
+  if (m_keysetColumns.size() == 1) {
+    return m_keysetColumns[0] + cmp + m_keysetValues[0].sql();
+  }
+
+  if (dialect().rowValueComparison()) {
+    std::string names;
+    std::string values;
+    for (std::size_t i = 0; i < m_keysetColumns.size(); i++) {
+      if (i > 0) {
+        names += ", ";
+        values += ", ";
+      }
+      names += m_keysetColumns[i];
+      values += m_keysetValues[i].sql();
+    }
+    return "(" + names + ")" + cmp + "(" + values + ")";
+  }
+
+  // a >= 1 AND (a > 1 OR (a = 1 AND b > 2)), the first part is for index range
+  std::string ret = m_keysetColumns[0] + (m_keysetDescending ? " <= " : " >= ") + m_keysetValues[0].sql() + " AND (";
+  for (std::size_t i = 0; i < m_keysetColumns.size(); i++) {
+    if (i > 0) {
+      ret += " OR (";
+      for (std::size_t j = 0; j < i; j++) {
+        ret += m_keysetColumns[j] + " = " + m_keysetValues[j].sql() + " AND ";
+      }
+    }
+    ret += m_keysetColumns[i] + cmp + m_keysetValues[i].sql();
+    if (i > 0) {
+      ret += ")";
+    }
+  }
+  return ret + ")";
+}
+
+std::string SqlSelect::orderByClause() {
+  // keyset columns are always the first
+  std::vector<std::pair<std::string, bool>> order;
+  for (auto col : m_keysetColumns) {
+    order.push_back(std::make_pair(col, m_keysetDescending));
+  }
+  order.insert(order.end(), m_orderBy.begin(), m_orderBy.end());
+  if (order.size() == 0) {
+    return "";
+  }
+  std::string ret = " ORDER BY ";
+  for (std::size_t i = 0; i < order.size(); i++) {
+    if (i > 0) {
+      ret += ", ";
+    }
+    ret += order[i].first;
+    if (order[i].second) {
+      ret += " DESC";
+    }
+  }
+  return ret;
+}
+
+bool SqlSelect::hasTable(const std::string &tableName) const {
+  if (SqlQuery::hasTable(tableName)) {
+    return true;
+  }
+  for (auto &join : m_joins) {
+    if (join.tableName == tableName) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string SqlSelect::sql() {
+  std::string ret = withClause() + "SELECT ";
+
+  if (m_columns.size() == 0) {
+    ret += "*";
+  } else {
+    bool first = true;
+    for (auto col : m_columns) {
+      if (!first) {
+        ret += ", ";
+      }
+      ret += col;
+      if (m_columns_as[col] != "") {
+        ret += " AS " + m_columns_as[col];
+      }
+      first = false;
+    }
+  }
+  ret += " FROM ";
+  ret += tableName();
+  if (m_alias != "") {
+    ret += " AS " + m_alias;
+  }
+  for (auto join : m_joins) {
+    ret += join.type == SqlJoinType::LEFT ? " LEFT JOIN " : " INNER JOIN ";
+    ret += join.tableName;
+    if (join.alias != "") {
+      ret += " AS " + join.alias;
+    }
+    std::string on = join.on->sql();
+    if (on == "") {
+      addError("SqlSelect. Expected ON conditions for join '" + join.tableName + "'");
+    } else {
+      ret += " ON " + on;
+    }
+  }
+
+  std::string where = m_where ? m_where->sql() : "";
+  if (m_keysetValues.size() > 0) {
+    if (where != "") {
+      bool hasOr = false;
+      for (auto item : m_where->conditions()) {
+        hasOr = hasOr || dynamic_cast<SqlWhereOr *>(item.get()) != nullptr;
+      }
+      where = (hasOr ? "(" + where + ")" : where) + " AND ";
+    }
+    where += keysetCondition();
+  }
+  if (where != "") {
+    ret += " WHERE " + where;
+  }
+
+  if (m_groupBy.size() > 0) {
+    ret += " GROUP BY ";
+    for (std::size_t i = 0; i < m_groupBy.size(); i++) {
+      ret += (i > 0 ? ", " : "") + m_groupBy[i];
+    }
+  }
+  if (m_having) {
+    ret += " HAVING " + m_having->sql();
+  }
+  ret += orderByClause();
+  ret += dialect().limitOffset(m_limit, m_offset);
+  return ret;
+}
+
+// ---------------------------------------------------------------------
+// SqlInsert
+
+SqlInsert::SqlInsert(const std::string &tableName, SqlBuilder *builder)
+: SqlQuery(SqlQueryType::INSERT, builder, tableName) {
+  m_onConflict = false;
+  m_conflictDoUpdate = false;
+  m_streamed = false;
+}
+
+SqlInsert &SqlInsert::colum(const std::string &col) {
+  m_columns.push_back(col);
+  mixFingerprint(SqlFingerprintToken::COLUMN, col);
+  return *this;
+}
+
+SqlInsert &SqlInsert::addColums(const std::vector<std::string> &cols) {
+  for (auto col : cols) {
+    colum(col);
+  }
+  return *this;
+}
+
+SqlInsert &SqlInsert::clearValues() {
+  m_values.clear();
+  m_rowsData.clear();
+  m_rowsEnds.clear();
+  return *this;
+}
+
+SqlInsert &SqlInsert::newRow() {
+  if (m_values.size() == 0) {
+    return *this;
+  }
+  if (m_values.size() != m_columns.size()) {
+    addError(
+      "SqlInsert. Expected " + std::to_string(m_columns.size()) + " values in row for '"
+      + tableName() + "', but got " + std::to_string(m_values.size())
+    );
+  }
+  renderRow(m_rowsData, m_values);
+  m_rowsEnds.push_back(m_rowsData.size());
+  m_values.clear();
+  return *this;
+}
+
+void SqlInsert::renderRow(std::string &out, const std::vector<std::string> &values) {
+  out += "(";
+  bool first = true;
+  for (const auto &val : values) {
+    if (!first) {
+      out += ", ";
+    }
+    out += val;
+    first = false;
+  }
+  out += ")";
+}
+
+std::string_view SqlInsert::finishedRow(std::size_t i) const {
+  std::size_t start = i > 0 ? m_rowsEnds[i - 1] : 0;
+  return std::string_view(m_rowsData).substr(start, m_rowsEnds[i] - start);
+}
+
+std::size_t SqlInsert::rowsCount() {
+  return m_rowsEnds.size() + (m_values.size() > 0 ? 1 : 0);
+}
+
+SqlInsert &SqlInsert::bulk(const SqlBulkColumns &columns) {
+  if (!columns.hasSameSizes()) {
+    addError("SqlInsert. Columns of bulk data for '" + tableName() + "' have different sizes");
+    return *this;
+  }
+  std::size_t count = columns.names().size();
+  if (m_columns.size() == 0) {
+    addColums(columns.names());
+  } else if (m_columns.size() != count) {
+    addError("SqlInsert. Count of columns is different from bulk data for '" + tableName() + "'");
+    return *this;
+  }
+  newRow();
+  std::size_t rows = columns.rowsCount();
+  if (count == 0 || rows == 0) {
+    return *this;
+  }
+
+  // column by column, so every loop formats values of one type
+  std::vector<std::string> buffers(count);
+  std::vector<std::vector<std::size_t>> ends(count);
+  std::size_t size = 0;
+  for (std::size_t c = 0; c < count; c++) {
+    ends[c].reserve(rows);
+    columns.format(c, dialect(), buffers[c], ends[c]);
+    size += buffers[c].size();
+  }
+
+  // "(" + ", " between values + ")"
+  m_rowsData.reserve(m_rowsData.size() + size + rows * 2 * count);
+  m_rowsEnds.reserve(m_rowsEnds.size() + rows);
+  for (std::size_t r = 0; r < rows; r++) {
+    m_rowsData += "(";
+    for (std::size_t c = 0; c < count; c++) {
+      if (c > 0) {
+        m_rowsData += ", ";
+      }
+      std::size_t start = r > 0 ? ends[c][r - 1] : 0;
+      m_rowsData.append(buffers[c], start, ends[c][r] - start);
+    }
+    m_rowsData += ")";
+    m_rowsEnds.push_back(m_rowsData.size());
+  }
+  return *this;
+}
+
+SqlInsert &SqlInsert::setChunkLimits(const SqlChunkLimits &limits) {
+  m_chunkLimits = limits;
+  return *this;
+}
+
+SqlChunkLimits SqlInsert::chunkLimits() {
+  if (m_chunkLimits.has_value()) {
+    return *m_chunkLimits;
+  }
+  return dialect().chunkLimits();
+}
+
+SqlInsert &SqlInsert::val(const std::string &val) {
+  m_values.push_back(dialect().escapeString(val));
+  return *this;
+}
+
+SqlInsert &SqlInsert::val(int val) {
+  m_values.push_back(std::to_string(val));
+  return *this;
+}
+
+SqlInsert &SqlInsert::val(long val) {
+  m_values.push_back(std::to_string(val));
+  return *this;
+}
+
+SqlInsert &SqlInsert::val(float val) {
+  m_values.push_back(std::to_string(val));
+  return *this;
+}
+
+SqlInsert &SqlInsert::val(double val) {
+  m_values.push_back(std::to_string(val));
+  return *this;
+}
+
+SqlInsert &SqlInsert::val(const SqlLiteral &val) {
+  m_values.push_back(val.sql());
+  return *this;
+}
+
+SqlInsert &SqlInsert::onConflict(const std::vector<std::string> &cols) {
+  if (m_onConflict) {
+    addError("[WARNING] SqlInsert. ON CONFLICT for '" + tableName() + "' already defined, current will be skipped.");
+    return *this;
+  }
+  m_onConflict = true;
+  m_conflictColumns = cols;
+  mixFingerprint(SqlFingerprintToken::ON_CONFLICT);
+  for (auto col : cols) {
+    mixFingerprint(SqlFingerprintToken::COLUMN, col);
+  }
+  return *this;
+}
+
+SqlInsert &SqlInsert::doNothing() {
+  if (!m_onConflict) {
+    onConflict();
+  }
+  m_conflictDoUpdate = false;
+  m_conflictUpdateColumns.clear();
+  mixFingerprint(SqlFingerprintToken::DO_NOTHING);
+  return *this;
+}
+
+SqlInsert &SqlInsert::doUpdateSet(const std::vector<std::string> &cols) {
+  if (!m_onConflict) {
+    addError("SqlInsert. doUpdateSet() for '" + tableName() + "' expected after onConflict()");
+    return *this;
+  }
+  if (m_conflictColumns.size() == 0 && dialect().conflictTargetRequired()) {
+    addError("SqlInsert. ON CONFLICT DO UPDATE for '" + tableName() + "' requires conflict target columns");
+    return *this;
+  }
+  m_conflictDoUpdate = true;
+  for (auto col : cols) {
+    auto it = std::find(m_conflictUpdateColumns.begin(), m_conflictUpdateColumns.end(), col);
+    if (it == m_conflictUpdateColumns.end()) {
+      m_conflictUpdateColumns.push_back(col);
+      mixFingerprint(SqlFingerprintToken::SET, col);
+    }
+  }
+  if (cols.size() == 0) {
+    mixFingerprint(SqlFingerprintToken::SET);
+  }
+  return *this;
+}
+
+SqlInsert &SqlInsert::returning(const std::vector<std::string> &cols) {
+  addReturning(cols);
+  return *this;
+}
+
+SqlSelect &SqlInsert::selectFrom(const std::string &tableName) {
+  if (rowsCount() > 0) {
+    addError("[WARNING] SqlInsert. Rows of insert into '" + this->tableName() + "' will be skipped, source is select.");
+  }
+  if (!m_select) {
+    m_select = std::make_shared<SqlSelect>(tableName, builderRawPtr());
+  }
+  return *(m_select.get());
+}
+
+uint64_t SqlInsert::fingerprint() const {
+  if (!m_select) {
+    return SqlQuery::fingerprint();
+  }
+  // combined with shape of the select
+  const uint64_t prime = 1099511628211ULL;
+  uint64_t ret = SqlQuery::fingerprint();
+  uint64_t source = m_select->fingerprint();
+  for (int i = 0; i < 8; i++) {
+    ret = (ret ^ ((source >> (i * 8)) & 0xFF)) * prime;
+  }
+  return ret;
+}
+
+std::string SqlInsert::conflictClause() {
+  if (!m_onConflict) {
+    return "";
+  }
+  std::vector<std::string> updateColumns;
+  if (m_conflictDoUpdate) {
+    updateColumns = m_conflictUpdateColumns;
+    if (updateColumns.size() == 0) {
+      for (auto col : m_columns) {
+        if (std::find(m_conflictColumns.begin(), m_conflictColumns.end(), col) == m_conflictColumns.end()) {
+          updateColumns.push_back(col);
+        }
+      }
+    }
+  }
+  auto identifiers = [this](const std::vector<std::string> &cols) {
+    std::vector<std::string> ret;
+    for (auto col : cols) {
+      ret.push_back(dialect().identifier(col));
+    }
+    return ret;
+  };
+  return dialect().upsertClause(identifiers(m_conflictColumns), identifiers(m_columns), identifiers(updateColumns));
+}
+
+std::string SqlInsert::sql() {
+  std::string ret;
+  for (auto statement : statements()) {
+    if (ret.size() > 0) {
+      ret += "\n";
+    }
+    ret += statement;
+  }
+  return ret;
+}
+
+std::vector<std::string> SqlInsert::statements() {
+  std::string header = columnsHeader();
+
+  // the same for every chunk
+  std::string suffix = conflictClause() + returningClause();
+  if (m_select) {
+    std::string select = m_select->sql();
+    if (suffix.size() > 0 && !m_select->m_where && dialect().insertSelectNeedsWhere()) {
+      select += " WHERE true";
+    }
+    return {header + " " + select + suffix};
+  }
+  header += " VALUES";
+  if (rowsCount() == 0) {
+    if (m_streamed) {
+      return {};
+    }
+    return {header + "()" + suffix};
+  }
+
+  SqlChunkLimits limits = chunkLimits();
+  std::vector<std::string> ret;
+  std::string statement;
+  std::size_t rows = 0;
+  std::string currentRow;
+  if (m_values.size() > 0) {
+    renderRow(currentRow, m_values);
+  }
+  for (std::size_t i = 0; i < rowsCount(); i++) {
+    std::string_view row = i < m_rowsEnds.size() ? finishedRow(i) : std::string_view(currentRow);
+    if (chunkFull(limits, rows, statement.size() + suffix.size(), row.size())) {
+      statement += suffix;
+      ret.push_back(std::move(statement));
+      rows = 0;
+    }
+    if (rows == 0) {
+      statement = header;
+    } else {
+      statement += ", ";
+    }
+    statement += row;
+    rows++;
+  }
+  statement += suffix;
+  ret.push_back(std::move(statement));
+  return ret;
+}
+
+std::size_t SqlInsert::stream(const std::function<bool(SqlInsert &)> &source, ISqlStatementSink &sink) {
+  std::string header = columnsHeader() + " VALUES";
+  std::string suffix = conflictClause() + returningClause();
+  SqlChunkLimits limits = chunkLimits();
+  std::size_t statements = 0;
+  // all finished rows are the current chunk
+  std::size_t rows = 0;
+  std::size_t size = header.size() + suffix.size();
+  m_streamed = true;
+  newRow();
+  bool more = true;
+  while (true) {
+    // rows added before and the pulled row
+    while (rows < m_rowsEnds.size()) {
+      std::size_t rowSize = finishedRow(rows).size();
+      if (chunkFull(limits, rows, size, rowSize)) {
+        sink.write(renderChunk(header, suffix, rows));
+        removeRows(rows);
+        statements++;
+        rows = 0;
+        size = header.size() + suffix.size();
+        continue;
+      }
+      size += (rows > 0 ? 2 : 0) + rowSize;
+      rows++;
+    }
+    if (!more) {
+      break;
+    }
+    more = source(*this);
+    newRow();
+  }
+  if (rows > 0) {
+    sink.write(renderChunk(header, suffix, rows));
+    removeRows(rows);
+    statements++;
+  }
+  return statements;
+}
+
+std::string SqlInsert::columnsHeader() {
+  std::string header = "INSERT INTO " + tableName();
+  // TODO if columns is empty
+  header += "(";
+  bool first = true;
+  for (auto col : m_columns) {
+    if (!first) {
+      header += ", ";
+    }
+    header += dialect().identifier(col);
+    first = false;
+  }
+  header += ")";
+  return header;
+}
+
+bool SqlInsert::chunkFull(const SqlChunkLimits &limits, std::size_t rows, std::size_t size, std::size_t rowSize) {
+  // the first row is always added, size is with ", " before the next row
+  return rows > 0 && (
+    (limits.maxRows > 0 && rows + 1 > limits.maxRows)
+    || (limits.maxBytes > 0 && size + 2 + rowSize > limits.maxBytes)
+    || (limits.maxVariables > 0 && (rows + 1) * m_columns.size() > limits.maxVariables)
+  );
+}
+
+std::string SqlInsert::renderChunk(const std::string &header, const std::string &suffix, std::size_t rows) {
+  std::string ret;
+  ret.reserve(header.size() + m_rowsEnds[rows - 1] + 2 * rows + suffix.size());
+  ret += header;
+  for (std::size_t i = 0; i < rows; i++) {
+    if (i > 0) {
+      ret += ", ";
+    }
+    ret += finishedRow(i);
+  }
+  ret += suffix;
+  return ret;
+}
+
+void SqlInsert::removeRows(std::size_t rows) {
+  std::size_t offset = m_rowsEnds[rows - 1];
+  m_rowsData.erase(0, offset);
+  m_rowsEnds.erase(m_rowsEnds.begin(), m_rowsEnds.begin() + rows);
+  for (auto &rowEnd : m_rowsEnds) {
+    rowEnd -= offset;
+  }
+}
+
+// ---------------------------------------------------------------------
+// SqlUpdate
+
+SqlUpdate::SqlUpdate(const std::string &tableName, SqlBuilder *builder)
+  : SqlQuery(SqlQueryType::UPDATE, builder, tableName) {
+
+}
+
+SqlUpdate &SqlUpdate::set(const std::string &name, const std::string &val) {
+  return setValue(name, dialect().escapeString(val));
+}
+
+SqlUpdate &SqlUpdate::set(const std::string &name, int val) {
+  return setValue(name, std::to_string(val));
+}
+
+SqlUpdate &SqlUpdate::set(const std::string &name, long val) {
+  return setValue(name, std::to_string(val));
+}
+
+SqlUpdate &SqlUpdate::set(const std::string &name, float val) {
+  return setValue(name, std::to_string(val));
+}
+
+SqlUpdate &SqlUpdate::set(const std::string &name, double val) {
+  return setValue(name, std::to_string(val));
+}
+
+SqlUpdate &SqlUpdate::set(const std::string &name, const SqlLiteral &val) {
+  return setValue(name, val.sql());
+}
+
+SqlUpdate &SqlUpdate::setValue(const std::string &name, const std::string &val) {
   auto it = std::find(m_columns.begin(), m_columns.end(), name);
   if (it != m_columns.end()) {
     m_values[name] = val;
@@ -364,6 +1818,7 @@ SqlUpdate &SqlUpdate::setValue(const std::string &name, const std::string &val)
   } else {
     m_columns.push_back(name);
     m_values[name] = val;
+    mixFingerprint(SqlFingerprintToken::SET, name);
   }
   return *this;
 }
@@ -371,12 +1826,23 @@ SqlUpdate &SqlUpdate::setValue(const std::string &name, const std::string &val)
 SqlWhere<SqlUpdate> &SqlUpdate::where() {
   if (!m_where) {
     m_where = std::make_shared<SqlWhere<SqlUpdate>>(nullptr, builderRawPtr(), this);
+    mixFingerprint(SqlFingerprintToken::WHERE);
   }
   return *(m_where.get());
 }
 
+SqlUpdate &SqlUpdate::returning(const std::vector<std::string> &cols) {
+  addReturning(cols);
+  return *this;
+}
+
+SqlUpdate &SqlUpdate::with(const std::string &name, SqlQuery &select) {
+  addWith(name, select);
+  return *this;
+}
+
 std::string SqlUpdate::sql() {
-  std::string ret = "UPDATE " + tableName() + " SET ";
+  std::string ret = withClause() + "UPDATE " + tableName() + " SET ";
 
   // TODO if columns is empty
   bool first = true;
@@ -384,7 +1850,7 @@ std::string SqlUpdate::sql() {
     if (!first) {
       ret += ", ";
     }
-    ret += col + " = " + m_values[col];
+    ret += dialect().identifier(col) + " = " + m_values[col];
     first = false;
   }
 
@@ -392,10 +1858,225 @@ std::string SqlUpdate::sql() {
     ret += " WHERE " + m_where->sql();
   }
 
-  return ret;
+  return ret + returningClause();
 };
 
 
+// ---------------------------------------------------------------------
+// SqlUpdateBatch
+
+SqlUpdateBatch::SqlUpdateBatch(const std::string &tableName, const std::string &keyColumn, SqlBuilder *builder)
+  : SqlQuery(SqlQueryType::UPDATE_BATCH, builder, tableName), m_keyColumn(keyColumn) {
+  mixFingerprint(SqlFingerprintToken::COLUMN, keyColumn);
+}
+
+const std::string &SqlUpdateBatch::keyColumn() {
+  return m_keyColumn;
+}
+
+SqlUpdateBatch &SqlUpdateBatch::colum(const std::string &col) {
+  if (col == m_keyColumn || std::find(m_columns.begin(), m_columns.end(), col) != m_columns.end()) {
+    addError("SqlUpdateBatch. Column '" + col + "' already added to update of '" + tableName() + "'");
+    return *this;
+  }
+  m_columns.push_back(col);
+  mixFingerprint(SqlFingerprintToken::SET, col);
+  return *this;
+}
+
+SqlUpdateBatch &SqlUpdateBatch::addColums(const std::vector<std::string> &cols) {
+  for (auto col : cols) {
+    colum(col);
+  }
+  return *this;
+}
+
+SqlUpdateBatch &SqlUpdateBatch::newRow() {
+  if (m_values.size() == 0) {
+    return *this;
+  }
+  if (m_values.size() != m_columns.size() + 1) {
+    addError(
+      "SqlUpdateBatch. Expected key and " + std::to_string(m_columns.size()) + " values in row for '"
+      + tableName() + "', but got " + std::to_string(m_values.size()) + " values"
+    );
+    m_values.clear();
+    return *this;
+  }
+  auto it = m_rowsByKey.find(m_values[0]);
+  if (it != m_rowsByKey.end()) {
+    m_rows[it->second] = std::move(m_values);
+  } else {
+    m_rowsByKey[m_values[0]] = m_rows.size();
+    m_rows.push_back(std::move(m_values));
+  }
+  m_values.clear();
+  return *this;
+}
+
+std::size_t SqlUpdateBatch::rowsCount() {
+  return allRows().size();
+}
+
+SqlUpdateBatch &SqlUpdateBatch::setChunkLimits(const SqlChunkLimits &limits) {
+  m_chunkLimits = limits;
+  return *this;
+}
+
+SqlChunkLimits SqlUpdateBatch::chunkLimits() {
+  if (m_chunkLimits.has_value()) {
+    return *m_chunkLimits;
+  }
+  return dialect().chunkLimits();
+}
+
+SqlUpdateBatch &SqlUpdateBatch::val(const std::string &val) {
+  m_values.push_back(dialect().escapeString(val));
+  return *this;
+}
+
+SqlUpdateBatch &SqlUpdateBatch::val(const char *val) {
+  return this->val(std::string(val));
+}
+
+SqlUpdateBatch &SqlUpdateBatch::val(int val) {
+  m_values.push_back(std::to_string(val));
+  return *this;
+}
+
+SqlUpdateBatch &SqlUpdateBatch::val(long val) {
+  m_values.push_back(std::to_string(val));
+  return *this;
+}
+
+SqlUpdateBatch &SqlUpdateBatch::val(float val) {
+  m_values.push_back(std::to_string(val));
+  return *this;
+}
+
+SqlUpdateBatch &SqlUpdateBatch::val(double val) {
+  m_values.push_back(std::to_string(val));
+  return *this;
+}
+
+SqlUpdateBatch &SqlUpdateBatch::val(const SqlLiteral &val) {
+  m_values.push_back(val.sql());
+  return *this;
+}
+
+std::string SqlUpdateBatch::sql() {
+  std::string ret;
+  for (auto statement : statements()) {
+    if (ret.size() > 0) {
+      ret += "\n";
+    }
+    ret += statement;
+  }
+  return ret;
+}
+
+std::vector<std::string> SqlUpdateBatch::statements() {
+  std::vector<const std::vector<std::string> *> rows = allRows();
+  if (rows.size() == 0 || m_columns.size() == 0) {
+    return {};
+  }
+  SqlChunkLimits limits = chunkLimits();
+  std::size_t baseSize = renderChunk(rows, 0, 0).size();
+  std::vector<std::string> ret;
+  std::size_t begin = 0;
+  std::size_t size = baseSize;
+  for (std::size_t i = 0; i < rows.size(); i++) {
+    std::size_t count = i - begin;
+    std::size_t nextSize = rowSize(*rows[i]);
+    bool full = count > 0 && (
+      (limits.maxRows > 0 && count + 1 > limits.maxRows)
+      || (limits.maxBytes > 0 && size + nextSize > limits.maxBytes)
+      || (limits.maxVariables > 0 && (count + 1) * (m_columns.size() + 1) > limits.maxVariables)
+    );
+    if (full) {
+      ret.push_back(renderChunk(rows, begin, i));
+      begin = i;
+      size = baseSize;
+    }
+    size += nextSize;
+  }
+  ret.push_back(renderChunk(rows, begin, rows.size()));
+  return ret;
+}
+
+std::vector<const std::vector<std::string> *> SqlUpdateBatch::allRows() {
+  std::vector<const std::vector<std::string> *> ret;
+  ret.reserve(m_rows.size() + 1);
+  for (const auto &row : m_rows) {
+    ret.push_back(&row);
+  }
+  // current row is not finished by newRow()
+  if (m_values.size() == m_columns.size() + 1) {
+    auto it = m_rowsByKey.find(m_values[0]);
+    if (it != m_rowsByKey.end()) {
+      ret[it->second] = &m_values;
+    } else {
+      ret.push_back(&m_values);
+    }
+  }
+  return ret;
+}
+
+std::size_t SqlUpdateBatch::rowSize(const std::vector<std::string> &row) {
+  std::size_t ret = 0;
+  if (dialect().batchUpdateFromValues()) {
+    // "(key, v1, v2), "
+    for (const auto &val : row) {
+      ret += val.size() + 2;
+    }
+    return ret + 2;
+  }
+  // " WHEN key THEN v" for every column and "key, " in IN
+  for (std::size_t i = 1; i < row.size(); i++) {
+    ret += 12 + row[0].size() + row[i].size();
+  }
+  return ret + row[0].size() + 2;
+}
+
+std::string SqlUpdateBatch::renderChunk(
+  const std::vector<const std::vector<std::string> *> &rows, std::size_t begin, std::size_t end
+) {
+  std::string ret = "UPDATE " + tableName() + " SET ";
+  if (dialect().batchUpdateFromValues()) {
+    for (std::size_t c = 0; c < m_columns.size(); c++) {
+      ret += (c > 0 ? ", " : "") + m_columns[c] + " = v." + m_columns[c];
+    }
+    ret += " FROM (VALUES ";
+    for (std::size_t r = begin; r < end; r++) {
+      ret += r > begin ? ", (" : "(";
+      for (std::size_t i = 0; i < rows[r]->size(); i++) {
+        ret += (i > 0 ? ", " : "") + (*rows[r])[i];
+      }
+      ret += ")";
+    }
+    ret += ") AS v(" + m_keyColumn;
+    for (auto col : m_columns) {
+      ret += ", " + col;
+    }
+    ret += ") WHERE " + tableName() + "." + m_keyColumn + " = v." + m_keyColumn;
+    return ret;
+  }
+
+  for (std::size_t c = 0; c < m_columns.size(); c++) {
+    ret += (c > 0 ? ", " : "") + m_columns[c] + " = CASE " + m_keyColumn;
+    for (std::size_t r = begin; r < end; r++) {
+      ret += " WHEN " + (*rows[r])[0] + " THEN " + (*rows[r])[c + 1];
+    }
+    ret += " END";
+  }
+  ret += " WHERE " + m_keyColumn + " IN (";
+  for (std::size_t r = begin; r < end; r++) {
+    ret += (r > begin ? ", " : "") + (*rows[r])[0];
+  }
+  ret += ")";
+  return ret;
+}
+
 // ---------------------------------------------------------------------
 // SqlDelete
 
@@ -404,28 +2085,336 @@ SqlDelete::SqlDelete(const std::string &tableName, SqlBuilder *builder)
 
 }
 
-SqlWhere<SqlDelete> &SqlDelete::where() {
-  if (!m_where) {
-    m_where = std::make_shared<SqlWhere<SqlDelete>>(nullptr, builderRawPtr(), this);
+SqlWhere<SqlDelete> &SqlDelete::where() {
+  if (!m_where) {
+    m_where = std::make_shared<SqlWhere<SqlDelete>>(nullptr, builderRawPtr(), this);
+    mixFingerprint(SqlFingerprintToken::WHERE);
+  }
+  return *(m_where.get());
+}
+
+SqlDelete &SqlDelete::returning(const std::vector<std::string> &cols) {
+  addReturning(cols);
+  return *this;
+}
+
+SqlDelete &SqlDelete::with(const std::string &name, SqlQuery &select) {
+  addWith(name, select);
+  return *this;
+}
+
+std::string SqlDelete::sql() {
+  std::string ret = withClause() + "DELETE FROM " + tableName();
+
+  if (m_where) {
+    ret += " WHERE " + m_where->sql();
+  }
+
+  return ret + returningClause();
+};
+
+// ---------------------------------------------------------------------
+// SqlCopyStringSink
+
+void SqlCopyStringSink::write(const char *data, std::size_t size) {
+  m_data.append(data, size);
+}
+
+const std::string &SqlCopyStringSink::data() const {
+  return m_data;
+}
+
+// ---------------------------------------------------------------------
+// SqlCopy
+
+SqlCopy::SqlCopy(const std::string &tableName, SqlBuilder *builder)
+  : SqlQuery(SqlQueryType::COPY, builder, tableName) {
+  m_format = SqlCopyFormat::TEXT;
+  m_sink = nullptr;
+  m_bufferSize = 0;
+  m_rowValues = 0;
+  m_rowsCount = 0;
+  m_started = false;
+  m_finished = false;
+}
+
+SqlCopy &SqlCopy::colum(const std::string &col) {
+  if (m_started) {
+    addError("SqlCopy. Columns for '" + tableName() + "' must be defined before values");
+    return *this;
+  }
+  m_columns.push_back(col);
+  mixFingerprint(SqlFingerprintToken::COLUMN, col);
+  return *this;
+}
+
+SqlCopy &SqlCopy::addColums(const std::vector<std::string> &cols) {
+  for (auto col : cols) {
+    colum(col);
+  }
+  return *this;
+}
+
+SqlCopy &SqlCopy::setFormat(SqlCopyFormat format) {
+  if (m_started) {
+    addError("SqlCopy. Format for '" + tableName() + "' must be defined before values");
+    return *this;
+  }
+  m_format = format;
+  mixFingerprint(SqlFingerprintToken::FORMAT, std::to_string(static_cast<int>(format)));
+  return *this;
+}
+
+SqlCopyFormat SqlCopy::format() {
+  return m_format;
+}
+
+SqlCopy &SqlCopy::setSink(ISqlCopySink *sink, std::size_t bufferSize) {
+  m_sink = sink;
+  m_bufferSize = bufferSize;
+  flush();
+  return *this;
+}
+
+SqlCopy &SqlCopy::val(const std::string &val) {
+  if (!beginValue()) {
+    return *this;
+  }
+  if (m_format == SqlCopyFormat::BINARY) {
+    writeInt32(static_cast<int32_t>(val.size()));
+    m_buffer += val;
+  } else {
+    writeText(val);
+  }
+  endValue();
+  return *this;
+}
+
+SqlCopy &SqlCopy::val(const char *val) {
+  return this->val(std::string(val));
+}
+
+SqlCopy &SqlCopy::val(int val) {
+  if (!beginValue()) {
+    return *this;
+  }
+  if (m_format == SqlCopyFormat::BINARY) {
+    writeInt32(4);
+    writeInt32(val);
+  } else {
+    SqlBuilderHelpers::appendNumber(m_buffer, static_cast<long long>(val));
+  }
+  endValue();
+  return *this;
+}
+
+SqlCopy &SqlCopy::val(long val) {
+  if (!beginValue()) {
+    return *this;
+  }
+  if (m_format == SqlCopyFormat::BINARY) {
+    writeInt32(8);
+    writeInt64(val);
+  } else {
+    SqlBuilderHelpers::appendNumber(m_buffer, static_cast<long long>(val));
+  }
+  endValue();
+  return *this;
+}
+
+SqlCopy &SqlCopy::val(float val) {
+  if (!beginValue()) {
+    return *this;
+  }
+  if (m_format == SqlCopyFormat::BINARY) {
+    int32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    writeInt32(4);
+    writeInt32(bits);
+  } else {
+    SqlBuilderHelpers::appendNumber(m_buffer, val);
+  }
+  endValue();
+  return *this;
+}
+
+SqlCopy &SqlCopy::val(double val) {
+  if (!beginValue()) {
+    return *this;
+  }
+  if (m_format == SqlCopyFormat::BINARY) {
+    int64_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    writeInt32(8);
+    writeInt64(bits);
+  } else {
+    SqlBuilderHelpers::appendNumber(m_buffer, val);
+  }
+  endValue();
+  return *this;
+}
+
+SqlCopy &SqlCopy::valNull() {
+  if (!beginValue()) {
+    return *this;
+  }
+  if (m_format == SqlCopyFormat::BINARY) {
+    writeInt32(-1);
+  } else {
+    m_buffer += "\\N";
+  }
+  endValue();
+  return *this;
+}
+
+std::size_t SqlCopy::rowsCount() {
+  return m_rowsCount;
+}
+
+SqlCopy &SqlCopy::finish() {
+  if (m_finished) {
+    return *this;
+  }
+  if (m_rowValues != 0) {
+    addError("SqlCopy. Last row for '" + tableName() + "' is not finished");
+  }
+  start();
+  if (m_format == SqlCopyFormat::BINARY) {
+    writeInt16(-1);
+  }
+  m_finished = true;
+  if (m_sink != nullptr && m_buffer.size() > 0) {
+    m_sink->write(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+  }
+  return *this;
+}
+
+const std::string &SqlCopy::payload() {
+  return m_buffer;
+}
+
+std::string SqlCopy::sql() {
+  std::string ret = "COPY " + tableName() + "(";
+  bool first = true;
+  for (auto col : m_columns) {
+    if (!first) {
+      ret += ", ";
+    }
+    ret += dialect().identifier(col);
+    first = false;
+  }
+  ret += ") FROM STDIN";
+  if (m_format == SqlCopyFormat::BINARY) {
+    ret += " (FORMAT binary)";
+  }
+  return ret;
+}
+
+bool SqlCopy::beginValue() {
+  if (m_finished) {
+    addError("SqlCopy. Values for '" + tableName() + "' added after finish()");
+    return false;
+  }
+  if (m_columns.size() == 0) {
+    addError("SqlCopy. Columns for '" + tableName() + "' must be defined before values");
+    return false;
+  }
+  start();
+  if (m_rowValues == 0 && m_format == SqlCopyFormat::BINARY) {
+    writeInt16(static_cast<int16_t>(m_columns.size()));
+  } else if (m_rowValues > 0 && m_format == SqlCopyFormat::TEXT) {
+    m_buffer += '\t';
+  }
+  return true;
+}
+
+void SqlCopy::start() {
+  if (!m_started && m_format == SqlCopyFormat::BINARY) {
+    // signature, flags and length of header extension
+    m_buffer.append("PGCOPY\n\377\r\n\0", 11);
+    writeInt32(0);
+    writeInt32(0);
+  }
+  m_started = true;
+}
+
+void SqlCopy::endValue() {
+  m_rowValues++;
+  if (m_rowValues < m_columns.size()) {
+    return;
   }
-  return *(m_where.get());
+  if (m_format == SqlCopyFormat::TEXT) {
+    m_buffer += '\n';
+  }
+  m_rowValues = 0;
+  m_rowsCount++;
+  flush();
 }
 
-std::string SqlDelete::sql() {
-  std::string ret = "DELETE FROM " + tableName();
+void SqlCopy::flush() {
+  // only full rows, so the payload can be sent by parts
+  if (m_sink != nullptr && m_rowValues == 0 && m_buffer.size() >= m_bufferSize) {
+    m_sink->write(m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+  }
+}
 
-  if (m_where) {
-    ret += " WHERE " + m_where->sql();
+void SqlCopy::writeText(const std::string &val) {
+  for (char c : val) {
+    if (c == '\\') {
+      m_buffer += "\\\\";
+    } else if (c == '\n') {
+      m_buffer += "\\n";
+    } else if (c == '\r') {
+      m_buffer += "\\r";
+    } else if (c == '\t') {
+      m_buffer += "\\t";
+    } else {
+      m_buffer += c;
+    }
   }
+}
 
-  return ret;
-};
+// network byte order
+void SqlCopy::writeInt16(int16_t val) {
+  uint16_t v = static_cast<uint16_t>(val);
+  m_buffer += static_cast<char>(v >> 8);
+  m_buffer += static_cast<char>(v);
+}
+
+void SqlCopy::writeInt32(int32_t val) {
+  uint32_t v = static_cast<uint32_t>(val);
+  writeInt16(static_cast<int16_t>(v >> 16));
+  writeInt16(static_cast<int16_t>(v));
+}
+
+void SqlCopy::writeInt64(int64_t val) {
+  uint64_t v = static_cast<uint64_t>(val);
+  writeInt32(static_cast<int32_t>(v >> 32));
+  writeInt32(static_cast<int32_t>(v));
+}
 
 // ---------------------------------------------------------------------
 // SqlBuilder
 
-SqlBuilder::SqlBuilder(SqlBuilderForDatabase dbType) : m_dbType(dbType) {
+SqlBuilder::SqlBuilder(SqlBuilderForDatabase dbType) {
+  setDatabaseType(dbType);
+  m_transaction = false;
+}
+
+SqlBuilder::SqlBuilder(const ISqlDialect &dialect) {
+  m_dialect = &dialect;
+  m_transaction = false;
+}
+
+void SqlBuilder::setTransaction(bool enabled, const SqlTransactionLimits &limits) {
+  m_transaction = enabled;
+  m_transactionLimits = limits;
+}
 
+bool SqlBuilder::isTransaction() const {
+  return m_transaction;
 }
 
 SqlSelect &SqlBuilder::selectFrom(const std::string &tableName) {
@@ -434,6 +2423,11 @@ SqlSelect &SqlBuilder::selectFrom(const std::string &tableName) {
   return *(SqlSelect *)(m_queries[m_queries.size() -1].get());
 }
 
+SqlSelect &SqlBuilder::subSelect(const std::string &tableName) {
+  m_subqueries.push_back(std::make_shared<SqlSelect>(tableName, this));
+  return *(SqlSelect *)(m_subqueries[m_subqueries.size() -1].get());
+}
+
 SqlInsert &SqlBuilder::insertInto(const std::string &tableName) {
   m_queries.push_back(std::make_shared<SqlInsert>(tableName, this));
   return *(SqlInsert *)(m_queries[m_queries.size() -1].get());
@@ -462,6 +2456,11 @@ SqlUpdate &SqlBuilder::findUpdateOrCreate(const std::string &tableName) {
   return update(tableName);
 }
 
+SqlUpdateBatch &SqlBuilder::updateBatch(const std::string &tableName, const std::string &keyColumn) {
+  m_queries.push_back(std::make_shared<SqlUpdateBatch>(tableName, keyColumn, this));
+  return *(SqlUpdateBatch *)(m_queries[m_queries.size() -1].get());
+}
+
 SqlDelete &SqlBuilder::deleteFrom(const std::string &tableName) {
   m_queries.push_back(std::make_shared<SqlDelete>(tableName, this));
   return *(SqlDelete *)(m_queries[m_queries.size() -1].get());
@@ -476,8 +2475,389 @@ SqlDelete &SqlBuilder::findDeleteOrCreate(const std::string &tableName) {
   return deleteFrom(tableName);
 }
 
+SqlCopy &SqlBuilder::copyInto(const std::string &tableName) {
+  if (!m_dialect->supportsCopy()) {
+    addError("SqlBuilder. COPY FROM STDIN is not supported by the database");
+  }
+  m_queries.push_back(std::make_shared<SqlCopy>(tableName, this));
+  return *(SqlCopy *)(m_queries[m_queries.size() -1].get());
+}
+
 void SqlBuilder::clear() {
   m_queries.clear();
+  m_coalescedQueries.clear();
+  m_subqueries.clear();
+}
+
+const SqlUpdateDeltaStats &SqlBuilder::updateDeltaStats() const {
+  return m_updateDeltaStats;
+}
+
+void SqlBuilder::resetUpdateDeltaStats() {
+  m_updateDeltaStats = SqlUpdateDeltaStats();
+}
+
+std::size_t SqlBuilder::coalesce() {
+  std::vector<std::shared_ptr<SqlQuery>> queries;
+  std::size_t begin = 0;
+  while (begin < m_queries.size()) {
+    std::size_t end = begin + 1;
+    while (end < m_queries.size() && canCoalesce(m_queries[begin], m_queries[end])) {
+      end++;
+    }
+    queries.push_back(end - begin > 1 ? coalesceRun(begin, end) : m_queries[begin]);
+    begin = end;
+  }
+  std::size_t removed = m_queries.size() - queries.size();
+  m_queries = queries;
+  return removed;
+}
+
+SqlSimplifyReport SqlBuilder::simplify() {
+  SqlSimplifyReport report;
+  std::vector<std::shared_ptr<SqlQuery>> queries;
+  for (auto query : m_queries) {
+    bool satisfiable = true;
+    if (query->sqlType() == SqlQueryType::SELECT) {
+      SqlSelect *select = (SqlSelect *)(query.get());
+      if (select->m_where) {
+        select->m_where->simplify(report); // client expects result, so 'WHERE 1 = 0' is kept
+      }
+      if (select->m_having) {
+        select->m_having->simplify(report);
+      }
+    } else if (query->sqlType() == SqlQueryType::UPDATE) {
+      SqlUpdate *update = (SqlUpdate *)(query.get());
+      satisfiable = !update->m_where || update->m_where->simplify(report);
+    } else if (query->sqlType() == SqlQueryType::DELETE) {
+      SqlDelete *del = (SqlDelete *)(query.get());
+      satisfiable = !del->m_where || del->m_where->simplify(report);
+    }
+    // client expects result of RETURNING, so such query is kept
+    if (!satisfiable && !query->hasReturning()) {
+      report.skippedQueries++;
+      m_coalescedQueries.push_back(query); // keep references alive
+      continue;
+    }
+    queries.push_back(query);
+  }
+  m_queries = queries;
+  return report;
+}
+
+SqlRewriteReport SqlBuilder::rewriteSargable() {
+  SqlRewriteReport report;
+  for (auto query : m_queries) {
+    SqlSelect *select = nullptr;
+    if (query->sqlType() == SqlQueryType::SELECT) {
+      select = (SqlSelect *)(query.get());
+    } else if (query->sqlType() == SqlQueryType::INSERT) {
+      select = ((SqlInsert *)(query.get()))->m_select.get();
+    } else if (query->sqlType() == SqlQueryType::UPDATE) {
+      SqlUpdate *update = (SqlUpdate *)(query.get());
+      if (update->m_where) {
+        update->m_where->rewriteSargable(dialect(), report);
+      }
+    } else if (query->sqlType() == SqlQueryType::DELETE) {
+      SqlDelete *del = (SqlDelete *)(query.get());
+      if (del->m_where) {
+        del->m_where->rewriteSargable(dialect(), report);
+      }
+    }
+    if (select == nullptr) {
+      continue;
+    }
+    for (auto join : select->m_joins) {
+      join.on->rewriteSargable(dialect(), report);
+    }
+    if (select->m_where) {
+      select->m_where->rewriteSargable(dialect(), report);
+    }
+  }
+  return report;
+}
+
+void SqlBuilder::registerLargeTable(const std::string &tableName) {
+  if (std::find(m_largeTables.begin(), m_largeTables.end(), tableName) == m_largeTables.end()) {
+    m_largeTables.push_back(tableName);
+  }
+}
+
+std::vector<std::string> SqlBuilder::lint([[maybe_unused]] const SqlLintOptions &options) {
+  std::vector<std::string> warnings;
+#ifndef NDEBUG
+  for (auto query : m_queries) {
+    std::string table = query->tableName();
+    if (query->sqlType() == SqlQueryType::SELECT) {
+      lintSelect(*(SqlSelect *)(query.get()), false, options, warnings);
+    } else if (query->sqlType() == SqlQueryType::INSERT) {
+      SqlInsert *insert = (SqlInsert *)(query.get());
+      if (insert->m_select) {
+        lintSelect(*insert->m_select, false, options, warnings);
+      }
+    } else if (query->sqlType() == SqlQueryType::UPDATE) {
+      SqlUpdate *update = (SqlUpdate *)(query.get());
+      if (update->m_where) {
+        lintWhere(*update->m_where, table, options, warnings);
+      } else if (isLargeTable(table)) {
+        warnings.push_back("UPDATE of large table '" + table + "' without where");
+      }
+    } else if (query->sqlType() == SqlQueryType::DELETE) {
+      SqlDelete *del = (SqlDelete *)(query.get());
+      if (del->m_where) {
+        lintWhere(*del->m_where, table, options, warnings);
+      } else if (isLargeTable(table)) {
+        warnings.push_back("DELETE from large table '" + table + "' without where");
+      }
+    }
+  }
+  // subqueries in conditions and CTE are rendered to the text of their queries,
+  // but they are kept by builder
+  for (auto query : m_subqueries) {
+    lintSelect(*(SqlSelect *)(query.get()), true, options, warnings);
+  }
+#endif
+  return warnings;
+}
+
+bool SqlBuilder::isLargeTable(const std::string &tableName) {
+  return std::find(m_largeTables.begin(), m_largeTables.end(), tableName) != m_largeTables.end();
+}
+
+void SqlBuilder::lintSelect(
+  SqlSelect &select, bool subquery, const SqlLintOptions &options, std::vector<std::string> &warnings
+) {
+  std::string table = select.tableName();
+  // EXISTS (SELECT * ...) reads nothing
+  if (select.m_columns.size() == 0 && !subquery) {
+    warnings.push_back("SELECT * from '" + table + "', all columns are read and sent");
+  }
+  // top-N by index is fine
+  if (isLargeTable(table) && !select.m_where && select.m_limit < 0) {
+    warnings.push_back("SELECT from large table '" + table + "' without where and limit");
+  }
+  for (auto join : select.m_joins) {
+    lintWhere(*join.on, join.tableName, options, warnings);
+  }
+  if (select.m_where) {
+    lintWhere(*select.m_where, table, options, warnings);
+  }
+  if (select.m_having) {
+    lintWhere(*select.m_having, table, options, warnings);
+  }
+}
+
+template<class T>
+void SqlBuilder::lintWhere(
+  SqlWhere<T> &where, const std::string &table, const SqlLintOptions &options, std::vector<std::string> &warnings
+) {
+  // columns of single terms between OR at this level (groups of AND are not compared),
+  // equals are counted by column
+  std::vector<std::string> orColumns;
+  std::map<std::string, std::size_t> orEquals;
+  bool hasOr = false;
+  bool termInGroup = false;
+  bool singleTerm = true;
+  std::string lastColumn;
+  bool lastEqual = false;
+
+  auto finishGroup = [&]() {
+    if (singleTerm && lastColumn != "") {
+      if (std::find(orColumns.begin(), orColumns.end(), lastColumn) == orColumns.end()) {
+        orColumns.push_back(lastColumn);
+      }
+      if (lastEqual) {
+        orEquals[lastColumn]++;
+      }
+    }
+    termInGroup = false;
+    singleTerm = true;
+    lastColumn = "";
+    lastEqual = false;
+  };
+
+  for (auto item : where.conditions()) {
+    if (item->type() == SqlWhereType::LOGICAL_OPERATOR) {
+      if (dynamic_cast<SqlWhereOr *>(item.get()) != nullptr) {
+        hasOr = true;
+        finishGroup();
+      }
+      continue;
+    }
+    if (termInGroup) {
+      singleTerm = false;
+    }
+    termInGroup = true;
+    if (item->type() == SqlWhereType::SUB_CONDITION) {
+      lintWhere(*std::static_pointer_cast<SqlWhere<T>>(item), table, options, warnings);
+      singleTerm = false;
+      continue;
+    }
+
+    auto cond = std::static_pointer_cast<SqlWhereCondition>(item);
+    lastColumn = cond->name();
+    lastEqual = cond->comparator() == SqlWhereConditionType::EQUAL && cond->value() != "NULL";
+    const std::string &value = cond->value();
+    if (cond->comparator() == SqlWhereConditionType::LIKE && value.size() > 1 && value[1] == '%') {
+      warnings.push_back("LIKE " + value + " with leading '%' on '" + table + "." + cond->name() + "', index can not be used");
+    }
+    // by count of values, strings in the list can contain ', ' too
+    bool list = (cond->comparator() == SqlWhereConditionType::IN || cond->comparator() == SqlWhereConditionType::NOT_IN)
+      && cond->listSize() > 1;
+    if (list) {
+      warnings.push_back(
+        "IN list of '" + table + "." + cond->name() + "' changes statement text by count of values, "
+        "inArray() keeps the same shape"
+      );
+    }
+  }
+  finishGroup();
+
+  if (!hasOr) {
+    return;
+  }
+  for (auto equals : orEquals) {
+    if (equals.second >= options.wideOrChain) {
+      warnings.push_back(
+        "OR chain of " + std::to_string(equals.second) + " equals on '" + table + "." + equals.first + "', better in()"
+      );
+    }
+  }
+  if (orColumns.size() > 1) {
+    std::string columns;
+    for (auto col : orColumns) {
+      columns += (columns.empty() ? "" : ", ") + col;
+    }
+    warnings.push_back("OR across different columns of '" + table + "' (" + columns + "), one index can not be used");
+  }
+}
+
+bool SqlBuilder::canCoalesce(const std::shared_ptr<SqlQuery> &first, const std::shared_ptr<SqlQuery> &next) {
+  if (first->sqlType() != next->sqlType() || first->tableName() != next->tableName()) {
+    return false;
+  }
+  // client expects own result of every statement
+  if (first->hasReturning() || next->hasReturning()) {
+    return false;
+  }
+  if (first->hasWith() || next->hasWith()) {
+    return false;
+  }
+  if (first->sqlType() == SqlQueryType::INSERT) {
+    SqlInsert *insert1 = (SqlInsert *)(first.get());
+    SqlInsert *insert2 = (SqlInsert *)(next.get());
+    // keys of rows can repeat: 'cannot affect row a second time'
+    if (insert1->m_conflictDoUpdate || insert2->m_conflictDoUpdate) {
+      return false;
+    }
+    return !insert1->m_select && !insert2->m_select
+      && insert1->m_columns == insert2->m_columns
+      && insert1->conflictClause() == insert2->conflictClause();
+  }
+  if (first->sqlType() == SqlQueryType::DELETE) {
+    std::string key1, key2, value;
+    return deleteByKey((SqlDelete *)(first.get()), key1, value)
+      && deleteByKey((SqlDelete *)(next.get()), key2, value)
+      && key1 == key2;
+  }
+  if (first->sqlType() == SqlQueryType::UPDATE) {
+    SqlUpdate *update1 = (SqlUpdate *)(first.get());
+    SqlUpdate *update2 = (SqlUpdate *)(next.get());
+    std::string where1 = update1->m_where ? update1->m_where->sql() : "";
+    std::string where2 = update2->m_where ? update2->m_where->sql() : "";
+    if (where1 != where2) {
+      return false;
+    }
+    // rows found by where must be the same for both updates,
+    // columns read by subqueries are not known: 'id IN (SELECT id FROM t WHERE status = 1)'
+    if (update1->m_where && update1->m_where->hasSubqueries()) {
+      return false;
+    }
+    std::vector<std::string> whereColumns;
+    if (update1->m_where) {
+      update1->m_where->columns(whereColumns);
+    }
+    for (auto col : whereColumns) {
+      bool updated1 = std::find(update1->m_columns.begin(), update1->m_columns.end(), col) != update1->m_columns.end();
+      bool updated2 = std::find(update2->m_columns.begin(), update2->m_columns.end(), col) != update2->m_columns.end();
+      if (updated1 || updated2) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+std::shared_ptr<SqlQuery> SqlBuilder::coalesceRun(std::size_t begin, std::size_t end) {
+  std::shared_ptr<SqlQuery> first = m_queries[begin];
+  for (std::size_t i = begin + 1; i < end; i++) {
+    m_coalescedQueries.push_back(m_queries[i]);
+  }
+
+  if (first->sqlType() == SqlQueryType::INSERT) {
+    SqlInsert *insert = (SqlInsert *)(first.get());
+    insert->newRow();
+    for (std::size_t i = begin + 1; i < end; i++) {
+      SqlInsert *other = (SqlInsert *)(m_queries[i].get());
+      other->newRow();
+      std::size_t offset = insert->m_rowsData.size();
+      insert->m_rowsData += other->m_rowsData;
+      for (auto rowEnd : other->m_rowsEnds) {
+        insert->m_rowsEnds.push_back(offset + rowEnd);
+      }
+    }
+    return first;
+  }
+
+  if (first->sqlType() == SqlQueryType::UPDATE) {
+    SqlUpdate *update = (SqlUpdate *)(first.get());
+    for (std::size_t i = begin + 1; i < end; i++) {
+      SqlUpdate *other = (SqlUpdate *)(m_queries[i].get());
+      for (auto col : other->m_columns) {
+        update->setValue(col, other->m_values[col]);
+      }
+    }
+    return first;
+  }
+
+  // delete, the new query so fingerprint is for IN condition
+  m_coalescedQueries.push_back(first);
+  std::string key;
+  std::vector<std::string> values;
+  std::vector<SqlLiteral> literals;
+  for (std::size_t i = begin; i < end; i++) {
+    std::string value;
+    deleteByKey((SqlDelete *)(m_queries[i].get()), key, value);
+    if (std::find(values.begin(), values.end(), value) == values.end()) {
+      values.push_back(value);
+      literals.push_back(SqlLiteral(value));
+    }
+  }
+  auto merged = std::make_shared<SqlDelete>(first->tableName(), this);
+  if (literals.size() == 1) {
+    merged->where().equal(key, literals[0]);
+  } else {
+    merged->where().in(key, literals);
+  }
+  return merged;
+}
+
+bool SqlBuilder::deleteByKey(SqlDelete *query, std::string &key, std::string &value) {
+  if (!query->m_where || query->m_where->conditions().size() != 1) {
+    return false;
+  }
+  auto item = query->m_where->conditions()[0];
+  if (item->type() != SqlWhereType::CONDITION) {
+    return false;
+  }
+  SqlWhereCondition *cond = (SqlWhereCondition *)(item.get());
+  if (cond->comparator() != SqlWhereConditionType::EQUAL || cond->value() == "NULL") {
+    return false;
+  }
+  key = cond->name();
+  value = cond->value();
+  return true;
 }
 
 bool SqlBuilder::hasErrors() {
@@ -490,22 +2870,356 @@ void SqlBuilder::addError(const std::string &err) {
 
 std::string SqlBuilder::sql() {
   std::string ret = "";
-  for (auto query : m_queries) {
+  for (auto statement : statements()) {
     if (ret.size() > 0) {
       ret += "\n";
     }
-    ret += query->sql();
+    ret += statement;
+  }
+  return ret;
+}
+
+std::vector<std::string> SqlBuilder::statements() {
+  std::vector<std::string> ret;
+  std::size_t statements = 0;
+  std::size_t bytes = 0;
+  for (auto query : m_queries) {
+    for (auto statement : query->statements()) {
+      if (!m_transaction) {
+        ret.push_back(std::move(statement));
+        continue;
+      }
+      bool full = statements > 0 && (
+        (m_transactionLimits.maxStatements > 0 && statements + 1 > m_transactionLimits.maxStatements)
+        || (m_transactionLimits.maxBytes > 0 && bytes + statement.size() > m_transactionLimits.maxBytes)
+      );
+      if (full) {
+        ret.push_back(m_dialect->commitTransaction());
+        statements = 0;
+        bytes = 0;
+      }
+      if (statements == 0) {
+        ret.push_back(m_dialect->beginTransaction());
+      }
+      bytes += statement.size();
+      statements++;
+      ret.push_back(std::move(statement));
+    }
+  }
+  if (statements > 0) {
+    ret.push_back(m_dialect->commitTransaction());
+  }
+  return ret;
+}
+
+std::string SqlBuilder::script() {
+  std::string ret;
+  for (auto statement : statements()) {
+    ret += statement + ";\n";
   }
   return ret;
 }
 
 
 void SqlBuilder::setDatabaseType(SqlBuilderForDatabase dbType) {
-  m_dbType = dbType;
+  switch (dbType) {
+    case SqlBuilderForDatabase::POSTGRESQL:
+      m_dialect = &SqlDialect<SqlDialectPostgreSQL>::instance();
+      break;
+    case SqlBuilderForDatabase::MYSQL:
+      m_dialect = &SqlDialect<SqlDialectMySQL>::instance();
+      break;
+    default:
+      m_dialect = &SqlDialect<SqlDialectSqlite3>::instance();
+      break;
+  }
 }
 
 SqlBuilderForDatabase SqlBuilder::databaseType() {
-  return m_dbType;
+  return m_dialect->databaseType();
+}
+
+const ISqlDialect &SqlBuilder::dialect() const {
+  return *m_dialect;
+}
+
+// ---------------------------------------------------------------------
+// SqlCodeGeneratorParam
+
+SqlCodeGeneratorParam::SqlCodeGeneratorParam(const std::string &name, const std::string &type)
+  : m_name(name), m_type(type) {
+
+}
+
+const std::string &SqlCodeGeneratorParam::name() const {
+  return m_name;
+}
+
+const std::string &SqlCodeGeneratorParam::type() const {
+  return m_type;
+}
+
+std::string SqlCodeGeneratorParam::cppType() const {
+  if (m_type == "string") {
+    return "const std::string &";
+  }
+  return m_type + " ";
+}
+
+// ---------------------------------------------------------------------
+// SqlCodeGeneratorQuery
+
+SqlCodeGeneratorQuery::SqlCodeGeneratorQuery(const std::string &name) : m_name(name) {
+
+}
+
+const std::string &SqlCodeGeneratorQuery::name() const {
+  return m_name;
+}
+
+const std::string &SqlCodeGeneratorQuery::sql() const {
+  return m_sql;
+}
+
+const std::vector<SqlCodeGeneratorParam> &SqlCodeGeneratorQuery::params() const {
+  return m_params;
+}
+
+const std::vector<std::size_t> &SqlCodeGeneratorQuery::slots() const {
+  return m_slots;
+}
+
+// ---------------------------------------------------------------------
+// SqlCodeGenerator
+
+bool SqlCodeGenerator::isIdentifier(const std::string &name) {
+  static const std::vector<std::string> keywords = {
+    "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case",
+    "catch", "char", "char16_t", "char32_t", "class", "compl", "const", "const_cast", "constexpr",
+    "continue", "decltype", "default", "delete", "do", "double", "dynamic_cast", "else", "enum",
+    "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int",
+    "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr", "operator", "or",
+    "or_eq", "private", "protected", "public", "register", "reinterpret_cast", "return", "short",
+    "signed", "sizeof", "static", "static_assert", "static_cast", "struct", "switch", "template",
+    "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename", "union",
+    "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq"
+  };
+  if (name.empty() || (name[0] >= '0' && name[0] <= '9')) {
+    return false;
+  }
+  for (char c : name) {
+    if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_')) {
+      return false;
+    }
+  }
+  // reserved for the implementation
+  if (name.find("__") != std::string::npos || (name[0] == '_' && name.size() > 1 && name[1] >= 'A' && name[1] <= 'Z')) {
+    return false;
+  }
+  return std::find(keywords.begin(), keywords.end(), name) == keywords.end();
+}
+
+static std::string trimCodeGeneratorLine(const std::string &line) {
+  std::size_t start = line.find_first_not_of(" \t\r");
+  if (start == std::string::npos) {
+    return "";
+  }
+  std::size_t end = line.find_last_not_of(" \t\r");
+  return line.substr(start, end - start + 1);
+}
+
+SqlCodeGenerator::SqlCodeGenerator() {
+
+}
+
+bool SqlCodeGenerator::parseSpec(const std::string &spec) {
+  std::vector<SqlCodeGeneratorQuery> queries;
+  int lineNumber = 0;
+  std::size_t pos = 0;
+  while (pos <= spec.size()) {
+    std::size_t end = spec.find('\n', pos);
+    if (end == std::string::npos) {
+      end = spec.size();
+    }
+    std::string line = trimCodeGeneratorLine(spec.substr(pos, end - pos));
+    pos = end + 1;
+    lineNumber++;
+
+    if (line.rfind("-- name:", 0) == 0) {
+      if (queries.size() > 0) {
+        finishQuery(queries[queries.size() - 1], lineNumber);
+      }
+      std::string name = trimCodeGeneratorLine(line.substr(8));
+      if (!isIdentifier(name)) {
+        m_errors.push_back("Line " + std::to_string(lineNumber) + ": invalid query name '" + name + "'");
+      } else if (hasName(queries, name) || hasName(m_queries, name)) {
+        // the function and its '<name>Sql' constant
+        m_errors.push_back("Line " + std::to_string(lineNumber) + ": duplicate query name '" + name + "'");
+      }
+      queries.push_back(SqlCodeGeneratorQuery(name));
+    } else if (line.rfind("-- param:", 0) == 0) {
+      std::string param = trimCodeGeneratorLine(line.substr(9));
+      std::size_t space = param.find(' ');
+      std::string name = param.substr(0, space);
+      std::string type = space == std::string::npos ? "" : trimCodeGeneratorLine(param.substr(space));
+      if (queries.size() == 0) {
+        m_errors.push_back("Line " + std::to_string(lineNumber) + ": param defined before '-- name:'");
+      } else if (!isIdentifier(name) || name == "ret" || name == "TDialect") {
+        // local and template param of the generated function too
+        m_errors.push_back("Line " + std::to_string(lineNumber) + ": invalid param name '" + name + "'");
+      } else if (hasParam(queries[queries.size() - 1], name)) {
+        m_errors.push_back("Line " + std::to_string(lineNumber) + ": duplicate param name '" + name + "'");
+      } else if (type != "string" && type != "int" && type != "long" && type != "float" && type != "double") {
+        m_errors.push_back("Line " + std::to_string(lineNumber) + ": unknown param type '" + type + "'");
+      } else {
+        queries[queries.size() - 1].m_params.push_back(SqlCodeGeneratorParam(name, type));
+      }
+    } else if (line.empty() || line.rfind("--", 0) == 0) {
+      // skip comments and empty lines
+    } else if (queries.size() == 0) {
+      m_errors.push_back("Line " + std::to_string(lineNumber) + ": sql defined before '-- name:'");
+    } else {
+      SqlCodeGeneratorQuery &query = queries[queries.size() - 1];
+      if (!query.m_sql.empty()) {
+        query.m_sql += " ";
+      }
+      query.m_sql += line;
+    }
+  }
+  if (queries.size() > 0) {
+    finishQuery(queries[queries.size() - 1], lineNumber);
+  }
+  for (auto query : queries) {
+    m_queries.push_back(query);
+  }
+  return !hasErrors();
+}
+
+bool SqlCodeGenerator::hasErrors() const {
+  return m_errors.size() > 0;
+}
+
+const std::vector<std::string> &SqlCodeGenerator::errors() const {
+  return m_errors;
+}
+
+const std::vector<SqlCodeGeneratorQuery> &SqlCodeGenerator::queries() const {
+  return m_queries;
+}
+
+bool SqlCodeGenerator::hasName(const std::vector<SqlCodeGeneratorQuery> &queries, const std::string &name) {
+  for (auto &query : queries) {
+    if (query.name() == name || query.name() + "Sql" == name || query.name() == name + "Sql") {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SqlCodeGenerator::hasParam(const SqlCodeGeneratorQuery &query, const std::string &name) {
+  for (auto &param : query.params()) {
+    if (param.name() == name) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SqlCodeGenerator::finishQuery(SqlCodeGeneratorQuery &query, int lineNumber) {
+  while (!query.m_sql.empty() && (query.m_sql.back() == ';' || query.m_sql.back() == ' ')) {
+    query.m_sql.pop_back();
+  }
+  if (query.m_sql.empty()) {
+    m_errors.push_back("Line " + std::to_string(lineNumber) + ": query '" + query.m_name + "' has no sql");
+    return;
+  }
+  // placeholders outside of string literals
+  bool inString = false;
+  for (std::size_t i = 0; i < query.m_sql.size(); i++) {
+    char c = query.m_sql[i];
+    if (c == '\'') {
+      inString = !inString;
+    } else if (c == '?' && !inString) {
+      query.m_slots.push_back(i);
+    }
+  }
+  if (query.m_slots.size() != query.m_params.size()) {
+    m_errors.push_back(
+      "Query '" + query.m_name + "' has " + std::to_string(query.m_slots.size())
+      + " placeholders, but " + std::to_string(query.m_params.size()) + " params"
+    );
+  }
+}
+
+std::string SqlCodeGenerator::cppStringLiteral(const std::string &value) {
+  std::string ret = "\"";
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      ret += '\\';
+    }
+    ret += c;
+  }
+  ret += "\"";
+  return ret;
+}
+
+std::string SqlCodeGenerator::generateHeader(const std::string &namespaceName, const std::string &specName) const {
+  std::string ret;
+  ret += "// Automatically generated by wsjcpp-sql-builder";
+  if (!specName.empty()) {
+    ret += " from " + specName;
+  }
+  ret += ", do not edit\n";
+  ret += "#pragma once\n\n";
+  ret += "#include <string>\n";
+  ret += "#include <wsjcpp_sql_builder.h>\n\n";
+  ret += "namespace " + namespaceName + " {\n";
+
+  for (auto query : m_queries) {
+    ret += "\n";
+    ret += "inline constexpr char " + query.name() + "Sql[] = " + cppStringLiteral(query.sql()) + ";\n\n";
+    if (query.params().size() > 0) {
+      ret += "template<class TDialect = wsjcpp::SqlDialectSqlite3>\n";
+    }
+    ret += "inline std::string " + query.name() + "(";
+    for (std::size_t i = 0; i < query.params().size(); i++) {
+      if (i > 0) {
+        ret += ", ";
+      }
+      ret += query.params()[i].cppType() + query.params()[i].name();
+    }
+    ret += ") {\n";
+    if (query.params().size() == 0) {
+      ret += "  return std::string(" + query.name() + "Sql, " + std::to_string(query.sql().size()) + ");\n";
+      ret += "}\n";
+      continue;
+    }
+    // one buffer, values are appended between parts of the sql
+    ret += "  std::string ret;\n";
+    ret += "  ret.reserve(" + std::to_string(query.sql().size() - query.params().size());
+    for (auto param : query.params()) {
+      ret += " + wsjcpp::SqlBuilderHelpers::maxValueSize(" + param.name() + ")";
+    }
+    ret += ");\n";
+    std::size_t pos = 0;
+    for (std::size_t i = 0; i < query.params().size(); i++) {
+      std::size_t slot = query.slots()[i];
+      if (slot > pos) {
+        ret += "  ret.append(" + query.name() + "Sql" + (pos > 0 ? " + " + std::to_string(pos) : "");
+        ret += ", " + std::to_string(slot - pos) + ");\n";
+      }
+      ret += "  wsjcpp::SqlBuilderHelpers::appendValue<TDialect>(ret, " + query.params()[i].name() + ");\n";
+      pos = slot + 1;
+    }
+    if (query.sql().size() > pos) {
+      ret += "  ret.append(" + query.name() + "Sql + " + std::to_string(pos);
+      ret += ", " + std::to_string(query.sql().size() - pos) + ");\n";
+    }
+    ret += "  return ret;\n";
+    ret += "}\n";
+  }
+  ret += "\n} // namespace " + namespaceName + "\n";
+  return ret;
 }
 
 } // namespace wsjcpp
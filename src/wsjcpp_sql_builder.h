@@ -27,10 +27,20 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
 #include <string>
+#include <string_view>
 #include <map>
 #include <vector>
 #include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
 
 namespace wsjcpp {
 
@@ -39,6 +49,8 @@ enum class SqlQueryType {
   INSERT,
   UPDATE,
   DELETE,
+  COPY,
+  UPDATE_BATCH,
 };
 
 enum class SqlWhereType {
@@ -53,15 +65,694 @@ enum class SqlWhereConditionType {
   MORE_THEN,
   LESS_THEN,
   LIKE,
+  IN,
+  NOT_IN,
+  IN_ARRAY,
+  NOT_IN_ARRAY,
+  EXISTS,
+  NOT_EXISTS,
+  MORE_OR_EQUAL,
+  LESS_OR_EQUAL,
+};
+
+enum class SqlFingerprintToken {
+  QUERY_TYPE,
+  TABLE,
+  COLUMN,
+  COLUMN_AS,
+  SET,
+  WHERE,
+  CONDITION,
+  LOGICAL_OR,
+  LOGICAL_AND,
+  SUB_CONDITION,
+  FORMAT,
+  ON_CONFLICT,
+  DO_NOTHING,
+  RETURNING,
+  KEYSET,
+  ORDER_BY,
+  GROUP_BY,
+  HAVING,
+  LIMIT,
+  OFFSET,
+  JOIN,
+  WITH,
+  SUBQUERY,
+  SIMPLIFIED,
+  REWRITTEN,
+  EMPTY_LIST,
+};
+
+enum class SqlJoinType {
+  INNER,
+  LEFT,
 };
 
 enum class SqlBuilderForDatabase {
   SQLITE3,
+  POSTGRESQL,
+  MYSQL,
+};
+
+enum class SqlCopyFormat {
+  TEXT,
+  BINARY,
 };
 
 class SqlBuilderHelpers {
 public:
   static std::string escapingStringValue(const std::string &sValue);
+  static void escapingStringValue(std::string &out, std::string_view sValue);
+
+  static std::string formatValue(const std::string &val);
+  static std::string formatValue(const char *val);
+  static std::string formatValue(int val);
+  static std::string formatValue(long val);
+  static std::string formatValue(float val);
+  static std::string formatValue(double val);
+
+  // strings are escaped by the dialect policy, like SqlDialectSqlite3
+  template<class TDialect, class TVal>
+  static std::string formatValue(const TVal &val) {
+    if constexpr (std::is_convertible<TVal, std::string>::value) {
+      return TDialect::escapeString(val);
+    } else {
+      return formatValue(val);
+    }
+  }
+
+  // element of JSON array: "a\"b"
+  static void appendJsonString(std::string &out, const std::string &val);
+  // element of PostgreSQL array literal: "a\"b"
+  static void appendArrayString(std::string &out, const std::string &val);
+
+  // 'abc%' -> abc, false if it is not a simple prefix pattern (other wildcards, escapes, quotes)
+  static bool likePrefix(const std::string &value, std::string &prefix);
+  // formatted number, string or NULL
+  static bool isValueLiteral(const std::string &val);
+  // name or table.name
+  static bool isColumnName(const std::string &val);
+
+  // formatted values are surely different (numbers or NULL), strings are not compared
+  static bool differentValues(const std::string &val1, const std::string &val2);
+
+  // append without temporary strings, float point numbers are the shortest text
+  // which is read back to the same value (0.5, 1e-07)
+  static void appendNumber(std::string &out, long long val);
+  static void appendNumber(std::string &out, unsigned long long val);
+  static void appendNumber(std::string &out, float val);
+  static void appendNumber(std::string &out, double val);
+
+  // the same text as formatValue(), appended without temporary strings
+  static void appendValue(std::string &out, int val);
+  static void appendValue(std::string &out, long val);
+  static void appendValue(std::string &out, float val);
+  static void appendValue(std::string &out, double val);
+
+  // strings are escaped by the dialect policy, like formatValue<TDialect>()
+  template<class TDialect, class TVal>
+  static void appendValue(std::string &out, const TVal &val) {
+    if constexpr (std::is_convertible<TVal, std::string_view>::value) {
+      TDialect::appendEscapedString(out, std::string_view(val));
+    } else {
+      appendValue(out, val);
+    }
+  }
+
+  // upper bound of the size appended by appendValue(), so a buffer is reserved only once
+  template<class TVal>
+  static std::size_t maxValueSize(const TVal &val) {
+    if constexpr (std::is_convertible<TVal, std::string_view>::value) {
+      return std::string_view(val).size() * 2 + 2; // quotes and every character escaped
+    } else if constexpr (std::is_floating_point<TVal>::value) {
+      return std::numeric_limits<TVal>::max_exponent10 + 10; // sign, digits, point and 6 decimals
+    } else {
+      return std::numeric_limits<long long>::digits10 + 2;
+    }
+  }
+
+  template<std::size_t N>
+  static constexpr bool isIdentifier(const char (&name)[N]) {
+    if (N < 2 || (name[0] >= '0' && name[0] <= '9')) {
+      return false;
+    }
+    for (std::size_t i = 0; i < N - 1; i++) {
+      char c = name[i];
+      bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '.';
+      if (!valid) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+// 0 means unlimited
+class SqlChunkLimits {
+public:
+  std::size_t maxRows = 0;       // rows per statement
+  std::size_t maxBytes = 0;      // like SQLITE_MAX_SQL_LENGTH
+  std::size_t maxVariables = 0;  // like SQLITE_MAX_VARIABLE_NUMBER, values per statement
+};
+
+// 0 means unlimited, so all statements in one transaction
+class SqlTransactionLimits {
+public:
+  std::size_t maxStatements = 0; // commit every N statements
+  std::size_t maxBytes = 0;      // commit every N bytes of statements
+};
+
+class SqlRewriteReport {
+public:
+  // 'before -> after' for every rewritten condition
+  std::vector<std::string> rewrites;
+};
+
+class SqlLintOptions {
+public:
+  std::size_t wideOrChain = 3; // 'x = 1 OR x = 2 OR x = 3' - better in()
+};
+
+class SqlSimplifyReport {
+public:
+  std::size_t flattenedGroups = 0;    // sub conditions merged to the parent
+  std::size_t removedDuplicates = 0;  // the same terms in AND, the same groups in OR
+  std::size_t rewrittenToIn = 0;      // 'x = 1 OR x = 2' chains replaced by 'x IN (1, 2)'
+  std::size_t contradictions = 0;     // always false groups, like 'x = 1 AND x = 2'
+  std::size_t skippedQueries = 0;     // updates and deletes with always false where
+};
+
+// ---------------------------------------------------------------------
+// Dialect policies: everything what differs between databases.
+// Builder for a policy known at compile time: BasicSqlBuilder<SqlDialectPostgreSQL>,
+// own policy can be derived from one of them with other static methods.
+
+class SqlDialectSqlite3 {
+public:
+  static constexpr SqlBuilderForDatabase databaseType = SqlBuilderForDatabase::SQLITE3;
+  // "name", quote inside is doubled
+  static std::string quoteIdentifier(const std::string &name);
+  static std::string escapeString(const std::string &val);
+  static void appendEscapedString(std::string &out, std::string_view val);
+  static std::string limitOffset(long limit, long offset);
+  static SqlChunkLimits chunkLimits();
+  static std::string beginTransaction();
+  static std::string commitTransaction();
+  // (a, b) > (1, 2)
+  static bool rowValueComparison();
+  // ON CONFLICT DO UPDATE needs conflict target columns
+  static bool conflictTargetRequired();
+  // batch update by key: 'UPDATE t SET c = v.c FROM (VALUES ...) AS v(...)' or 'SET c = CASE key WHEN ...'
+  static bool batchUpdateFromValues();
+  // RETURNING clause for insert, update and delete
+  static bool supportsReturning();
+  // INSERT ... SELECT without WHERE can not be followed by upsert clause
+  static bool insertSelectNeedsWhere();
+  // literal for IN_ARRAY (not escaped yet): items are formatted numbers or strings if 'strings' is true
+  static std::string arrayLiteral(const std::vector<std::string> &items, bool strings);
+  // 'name IN (...)' for array literal
+  static std::string inArray(const std::string &name, bool notIn, const std::string &array);
+  // COPY FROM STDIN for SqlCopy
+  static bool supportsCopy();
+  // prefix LIKE is rewritten to range: col >= 'abc' AND col < 'abd' (see SqlBuilder::rewriteSargable)
+  static bool likePrefixRange();
+  // clause after values of insert, updateColumns are empty for DO NOTHING
+  static std::string upsertClause(
+    const std::vector<std::string> &conflictColumns,
+    const std::vector<std::string> &insertColumns,
+    const std::vector<std::string> &updateColumns
+  );
+  // placeholder of prepared statement for index from 1, written to out (when it is not null),
+  // returns length, so it can be used for sizes of compile-time strings (see SqlStaticStatement)
+  static constexpr std::size_t placeholder(std::size_t /*index*/, char *out) {
+    if (out != nullptr) {
+      out[0] = '?';
+    }
+    return 1;
+  }
+};
+
+class SqlDialectPostgreSQL {
+public:
+  static constexpr SqlBuilderForDatabase databaseType = SqlBuilderForDatabase::POSTGRESQL;
+  static std::string quoteIdentifier(const std::string &name);
+  static std::string escapeString(const std::string &val);
+  static void appendEscapedString(std::string &out, std::string_view val);
+  static std::string limitOffset(long limit, long offset);
+  static SqlChunkLimits chunkLimits();
+  static std::string beginTransaction();
+  static std::string commitTransaction();
+  static bool rowValueComparison();
+  static bool conflictTargetRequired();
+  static bool batchUpdateFromValues();
+  static bool supportsReturning();
+  static bool insertSelectNeedsWhere();
+  static std::string arrayLiteral(const std::vector<std::string> &items, bool strings);
+  static std::string inArray(const std::string &name, bool notIn, const std::string &array);
+  static bool supportsCopy();
+  static bool likePrefixRange();
+  static std::string upsertClause(
+    const std::vector<std::string> &conflictColumns,
+    const std::vector<std::string> &insertColumns,
+    const std::vector<std::string> &updateColumns
+  );
+  // $1, $2, ...
+  static constexpr std::size_t placeholder(std::size_t index, char *out) {
+    std::size_t digits = 1;
+    for (std::size_t value = index; value >= 10; value /= 10) {
+      digits++;
+    }
+    if (out != nullptr) {
+      out[0] = '$';
+      for (std::size_t d = digits, value = index; d > 0; d--, value /= 10) {
+        out[d] = static_cast<char>('0' + value % 10);
+      }
+    }
+    return digits + 1;
+  }
+};
+
+class SqlDialectMySQL {
+public:
+  static constexpr SqlBuilderForDatabase databaseType = SqlBuilderForDatabase::MYSQL;
+  // `name`
+  static std::string quoteIdentifier(const std::string &name);
+  static std::string escapeString(const std::string &val);
+  static void appendEscapedString(std::string &out, std::string_view val);
+  static std::string limitOffset(long limit, long offset);
+  static SqlChunkLimits chunkLimits();
+  static std::string beginTransaction();
+  static std::string commitTransaction();
+  static bool rowValueComparison();
+  static bool conflictTargetRequired();
+  static bool batchUpdateFromValues();
+  static bool supportsReturning();
+  static bool insertSelectNeedsWhere();
+  static std::string arrayLiteral(const std::vector<std::string> &items, bool strings);
+  static std::string inArray(const std::string &name, bool notIn, const std::string &array);
+  static bool supportsCopy();
+  static bool likePrefixRange();
+  static std::string upsertClause(
+    const std::vector<std::string> &conflictColumns,
+    const std::vector<std::string> &insertColumns,
+    const std::vector<std::string> &updateColumns
+  );
+  static constexpr std::size_t placeholder(std::size_t index, char *out) {
+    return SqlDialectSqlite3::placeholder(index, out);
+  }
+};
+
+class ISqlDialect {
+public:
+  virtual ~ISqlDialect() { }
+  virtual SqlBuilderForDatabase databaseType() const = 0;
+  virtual std::string quoteIdentifier(const std::string &name) const = 0;
+  virtual std::string escapeString(const std::string &val) const = 0;
+  virtual void appendEscapedString(std::string &out, std::string_view val) const = 0;
+  // negative means not defined, returns clause with leading space or empty string
+  virtual std::string limitOffset(long limit, long offset) const = 0;
+  virtual SqlChunkLimits chunkLimits() const = 0;
+  virtual std::string beginTransaction() const = 0;
+  virtual std::string commitTransaction() const = 0;
+  virtual bool rowValueComparison() const = 0;
+  virtual bool conflictTargetRequired() const = 0;
+  virtual bool batchUpdateFromValues() const = 0;
+  virtual bool supportsReturning() const = 0;
+  virtual bool insertSelectNeedsWhere() const = 0;
+  virtual std::string arrayLiteral(const std::vector<std::string> &items, bool strings) const = 0;
+  virtual std::string inArray(const std::string &name, bool notIn, const std::string &array) const = 0;
+  virtual bool supportsCopy() const = 0;
+  virtual bool likePrefixRange() const = 0;
+  virtual std::string upsertClause(
+    const std::vector<std::string> &conflictColumns,
+    const std::vector<std::string> &insertColumns,
+    const std::vector<std::string> &updateColumns
+  ) const = 0;
+  virtual std::string placeholder(std::size_t index) const = 0;
+
+  // quoteIdentifier() for reserved words ('order', 'group'), other names and expressions are as is
+  std::string identifier(const std::string &name) const;
+};
+
+template<class TDialect>
+class SqlDialect : public ISqlDialect {
+public:
+  static const SqlDialect<TDialect> &instance() {
+    static const SqlDialect<TDialect> dialect;
+    return dialect;
+  }
+  virtual SqlBuilderForDatabase databaseType() const override { return TDialect::databaseType; }
+  virtual std::string quoteIdentifier(const std::string &name) const override { return TDialect::quoteIdentifier(name); }
+  virtual std::string escapeString(const std::string &val) const override { return TDialect::escapeString(val); }
+  virtual void appendEscapedString(std::string &out, std::string_view val) const override { TDialect::appendEscapedString(out, val); }
+  virtual std::string limitOffset(long limit, long offset) const override { return TDialect::limitOffset(limit, offset); }
+  virtual SqlChunkLimits chunkLimits() const override { return TDialect::chunkLimits(); }
+  virtual std::string beginTransaction() const override { return TDialect::beginTransaction(); }
+  virtual std::string commitTransaction() const override { return TDialect::commitTransaction(); }
+  virtual bool rowValueComparison() const override { return TDialect::rowValueComparison(); }
+  virtual bool conflictTargetRequired() const override { return TDialect::conflictTargetRequired(); }
+  virtual bool batchUpdateFromValues() const override { return TDialect::batchUpdateFromValues(); }
+  virtual bool supportsReturning() const override { return TDialect::supportsReturning(); }
+  virtual bool insertSelectNeedsWhere() const override { return TDialect::insertSelectNeedsWhere(); }
+  virtual std::string arrayLiteral(const std::vector<std::string> &items, bool strings) const override {
+    return TDialect::arrayLiteral(items, strings);
+  }
+  virtual std::string inArray(const std::string &name, bool notIn, const std::string &array) const override {
+    return TDialect::inArray(name, notIn, array);
+  }
+  virtual bool supportsCopy() const override { return TDialect::supportsCopy(); }
+  virtual bool likePrefixRange() const override { return TDialect::likePrefixRange(); }
+  virtual std::string upsertClause(
+    const std::vector<std::string> &conflictColumns,
+    const std::vector<std::string> &insertColumns,
+    const std::vector<std::string> &updateColumns
+  ) const override {
+    return TDialect::upsertClause(conflictColumns, insertColumns, updateColumns);
+  }
+  virtual std::string placeholder(std::size_t index) const override {
+    std::string ret(TDialect::placeholder(index, nullptr), '\0');
+    TDialect::placeholder(index, &ret[0]);
+    return ret;
+  }
+};
+
+// already formatted value (escaped string, number or NULL)
+class SqlLiteral {
+public:
+  explicit SqlLiteral(const std::string &sql);
+  static SqlLiteral null();
+  const std::string &sql() const;
+  bool isNull() const;
+
+private:
+  std::string m_sql;
+};
+
+// ---------------------------------------------------------------------
+// Typed schema: tables and columns declared as C++ types
+//
+//   class Users : public wsjcpp::SqlTableDef {
+//   public:
+//     static constexpr char name[] = "users";
+//   };
+//   class UsersId : public wsjcpp::SqlColumnDef<Users, long, wsjcpp::SqlColumnKind::PRIMARY_KEY> {
+//   public:
+//     static constexpr char name[] = "id";
+//   };
+
+template<class TValue>
+class SqlValueTraits; // not defined for unsupported types
+
+template<>
+class SqlValueTraits<int> {
+public:
+  static constexpr char sqlType[] = "INTEGER";
+  template<class TVal>
+  static constexpr bool accepts = std::is_integral<TVal>::value && !std::is_same<TVal, bool>::value && sizeof(TVal) <= sizeof(int);
+  static std::string format(const ISqlDialect &, int val) { return std::to_string(val); }
+};
+
+template<>
+class SqlValueTraits<long> {
+public:
+  static constexpr char sqlType[] = "INTEGER";
+  template<class TVal>
+  static constexpr bool accepts = std::is_integral<TVal>::value && !std::is_same<TVal, bool>::value && sizeof(TVal) <= sizeof(long);
+  static std::string format(const ISqlDialect &, long val) { return std::to_string(val); }
+};
+
+template<>
+class SqlValueTraits<float> {
+public:
+  static constexpr char sqlType[] = "REAL";
+  template<class TVal>
+  static constexpr bool accepts = std::is_arithmetic<TVal>::value && !std::is_same<TVal, bool>::value;
+  static std::string format(const ISqlDialect &, float val) {
+    std::string ret;
+    SqlBuilderHelpers::appendNumber(ret, val); // shortest text, 1e-07 is not 0.000000
+    return ret;
+  }
+};
+
+template<>
+class SqlValueTraits<double> {
+public:
+  static constexpr char sqlType[] = "REAL";
+  template<class TVal>
+  static constexpr bool accepts = std::is_arithmetic<TVal>::value && !std::is_same<TVal, bool>::value;
+  static std::string format(const ISqlDialect &, double val) {
+    std::string ret;
+    SqlBuilderHelpers::appendNumber(ret, val); // shortest text, 1e-07 is not 0.000000
+    return ret;
+  }
+};
+
+template<>
+class SqlValueTraits<std::string> {
+public:
+  static constexpr char sqlType[] = "TEXT";
+  template<class TVal>
+  static constexpr bool accepts = std::is_convertible<TVal, std::string>::value;
+  static std::string format(const ISqlDialect &dialect, const std::string &val) { return dialect.escapeString(val); }
+};
+
+enum class SqlColumnKind {
+  NOT_NULL,
+  NULLABLE,
+  PRIMARY_KEY,
+};
+
+class SqlTableDef { };
+
+class SqlColumnDefBase { };
+
+template<class T>
+class SqlIsOptional : public std::false_type { };
+
+template<class T>
+class SqlIsOptional<std::optional<T>> : public std::true_type { };
+
+template<class TTable, class TValue, SqlColumnKind TKind = SqlColumnKind::NOT_NULL>
+class SqlColumnDef : public SqlColumnDefBase {
+public:
+  static_assert(std::is_base_of<SqlTableDef, TTable>::value, "Table of the column must be derived from SqlTableDef");
+
+  using table_type = TTable;
+  using value_type = TValue;
+  static constexpr SqlColumnKind kind = TKind;
+  static constexpr bool nullable = TKind == SqlColumnKind::NULLABLE;
+  static constexpr bool primaryKey = TKind == SqlColumnKind::PRIMARY_KEY;
+  static constexpr const char *sqlType = SqlValueTraits<TValue>::sqlType;
+
+  template<class TVal>
+  static SqlLiteral literal(const ISqlDialect &dialect, const TVal &val) {
+    if constexpr (std::is_same<TVal, std::nullopt_t>::value) {
+      static_assert(nullable, "NULL is not allowed for the column");
+      return SqlLiteral::null();
+    } else if constexpr (SqlIsOptional<TVal>::value) {
+      static_assert(nullable, "Optional value is not allowed for the not nullable column");
+      return val.has_value() ? literal(dialect, *val) : SqlLiteral::null();
+    } else {
+      static_assert(SqlValueTraits<TValue>::template accepts<TVal>, "Value type does not match to the column type");
+      return SqlLiteral(SqlValueTraits<TValue>::format(dialect, static_cast<TValue>(val)));
+    }
+  }
+};
+
+template<class TColumn>
+class SqlIsColumnDef : public std::is_base_of<SqlColumnDefBase, TColumn> { };
+
+template<class TTable, class TColumn>
+class SqlIsTableColumn : public std::is_same<TTable, typename TColumn::table_type> { };
+
+// ---------------------------------------------------------------------
+// Mapping of struct fields to table columns, registered once:
+//
+//   wsjcpp::SqlRowMapping<User> mapping("users");
+//   mapping.primaryKey("id", &User::id).colum("name", &User::name);
+//   builder.insertObjects(mapping, users);
+
+template<class T>
+class SqlRowMapping {
+public:
+  SqlRowMapping(const std::string &tableName) : m_tableName(tableName) { }
+
+  template<class TField>
+  SqlRowMapping<T> &colum(const std::string &name, TField T::*member) {
+    return addField(name, member, false);
+  }
+
+  template<class TField>
+  SqlRowMapping<T> &primaryKey(const std::string &name, TField T::*member) {
+    return addField(name, member, true);
+  }
+
+  const std::string &tableName() const { return m_tableName; }
+  const std::vector<std::string> &columns() const { return m_columns; }
+  std::size_t size() const { return m_fields.size(); }
+  const std::string &name(std::size_t i) const { return m_columns[i]; }
+  bool isPrimaryKey(std::size_t i) const { return m_fields[i].primaryKey; }
+  bool hasPrimaryKey() const { return m_hasPrimaryKey; }
+  SqlLiteral literal(const ISqlDialect &dialect, std::size_t i, const T &obj) const {
+    return m_fields[i].literal(dialect, obj);
+  }
+  bool equal(std::size_t i, const T &obj1, const T &obj2) const { return m_fields[i].equal(obj1, obj2); }
+
+private:
+  class Field {
+  public:
+    bool primaryKey;
+    std::function<SqlLiteral(const ISqlDialect &, const T &)> literal;
+    std::function<bool(const T &, const T &)> equal;
+  };
+
+  template<class TField>
+  static SqlLiteral format(const ISqlDialect &dialect, const TField &val) {
+    if constexpr (SqlIsOptional<TField>::value) {
+      return val.has_value() ? format(dialect, *val) : SqlLiteral::null();
+    } else {
+      return SqlLiteral(SqlValueTraits<TField>::format(dialect, val));
+    }
+  }
+
+  template<class TField>
+  SqlRowMapping<T> &addField(const std::string &name, TField T::*member, bool primaryKey) {
+    Field field;
+    field.primaryKey = primaryKey;
+    field.literal = [member](const ISqlDialect &dialect, const T &obj) { return format(dialect, obj.*member); };
+    field.equal = [member](const T &obj1, const T &obj2) { return obj1.*member == obj2.*member; };
+    m_fields.push_back(field);
+    m_columns.push_back(name);
+    m_hasPrimaryKey = m_hasPrimaryKey || primaryKey;
+    return *this;
+  }
+
+  std::string m_tableName;
+  std::vector<std::string> m_columns;
+  std::vector<Field> m_fields;
+  bool m_hasPrimaryKey = false;
+};
+
+// ---------------------------------------------------------------------
+// Column-wise data for SqlInsert::bulk(), the same as std::span (C++20) over const data.
+// Validity bitmap is optional and has the same layout as in Apache Arrow:
+// bit (i % 8) of byte (i / 8) is 1 for a value and 0 for NULL
+//
+//   wsjcpp::SqlBulkColumns columns;
+//   columns.colum("id", ids).colum("score", scores, scoresValidity);
+//   builder.insertInto("scores").bulk(columns);
+
+template<class T>
+class SqlColumnSpan {
+public:
+  SqlColumnSpan(const T *data, std::size_t size, const uint8_t *validity = nullptr)
+    : m_data(data), m_size(size), m_validity(validity) { }
+  SqlColumnSpan(const std::vector<T> &data, const uint8_t *validity = nullptr)
+    : m_data(data.data()), m_size(data.size()), m_validity(validity) { }
+
+  const T *data() const { return m_data; }
+  std::size_t size() const { return m_size; }
+  const T &operator[](std::size_t i) const { return m_data[i]; }
+  bool isNull(std::size_t i) const {
+    return m_validity != nullptr && (m_validity[i / 8] & (1 << (i % 8))) == 0;
+  }
+
+private:
+  const T *m_data;
+  std::size_t m_size;
+  const uint8_t *m_validity;
+};
+
+// data is not copied, so it must be alive until SqlInsert::bulk() is called
+class SqlBulkColumns {
+public:
+  template<class T>
+  SqlBulkColumns &colum(const std::string &name, const SqlColumnSpan<T> &values) {
+    static_assert(
+      std::is_arithmetic<T>::value != std::is_convertible<T, std::string>::value && !std::is_same<T, bool>::value,
+      "Supported only numbers and strings"
+    );
+    if (m_names.size() == 0) {
+      m_rowsCount = values.size();
+    } else if (m_rowsCount != values.size()) {
+      m_sameSizes = false;
+    }
+    m_names.push_back(name);
+    // every column is formatted by own tight loop into one buffer
+    m_formatters.push_back([values](const ISqlDialect &dialect, std::string &buffer, std::vector<std::size_t> &ends) {
+      for (std::size_t i = 0; i < values.size(); i++) {
+        if (values.isNull(i)) {
+          buffer += "NULL";
+        } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+          SqlBuilderHelpers::appendNumber(buffer, static_cast<long long>(values[i]));
+        } else if constexpr (std::is_integral<T>::value) {
+          SqlBuilderHelpers::appendNumber(buffer, static_cast<unsigned long long>(values[i]));
+        } else if constexpr (std::is_same<T, float>::value) {
+          SqlBuilderHelpers::appendNumber(buffer, values[i]);
+        } else if constexpr (std::is_floating_point<T>::value) {
+          SqlBuilderHelpers::appendNumber(buffer, static_cast<double>(values[i]));
+        } else {
+          dialect.appendEscapedString(buffer, values[i]);
+        }
+        ends.push_back(buffer.size());
+      }
+    });
+    return *this;
+  }
+
+  template<class T>
+  SqlBulkColumns &colum(const std::string &name, const std::vector<T> &values, const uint8_t *validity = nullptr) {
+    return colum(name, SqlColumnSpan<T>(values, validity));
+  }
+
+  const std::vector<std::string> &names() const { return m_names; }
+  std::size_t rowsCount() const { return m_rowsCount; }
+  bool hasSameSizes() const { return m_sameSizes; }
+
+  // appends formatted values of the column to buffer, ends[row] is the end offset of the value
+  void format(std::size_t colum, const ISqlDialect &dialect, std::string &buffer, std::vector<std::size_t> &ends) const {
+    m_formatters[colum](dialect, buffer, ends);
+  }
+
+private:
+  std::vector<std::string> m_names;
+  std::vector<std::function<void(const ISqlDialect &, std::string &, std::vector<std::size_t> &)>> m_formatters;
+  std::size_t m_rowsCount = 0;
+  bool m_sameSizes = true;
+};
+
+// Key values of the last row of a page for keyset pagination.
+// Token keeps typed values (not sql), so values are escaped again when the token is used.
+class SqlKeysetCursor {
+public:
+  SqlKeysetCursor &val(int value);
+  SqlKeysetCursor &val(long value);
+  SqlKeysetCursor &val(long long value);
+  SqlKeysetCursor &val(float value);
+  SqlKeysetCursor &val(double value);
+  SqlKeysetCursor &val(const std::string &value);
+  SqlKeysetCursor &val(const char *value);
+
+  template<typename... TVals>
+  static SqlKeysetCursor of(const TVals &...vals) {
+    SqlKeysetCursor cursor;
+    (cursor.val(vals), ...);
+    return cursor;
+  }
+
+  std::size_t size() const;
+  bool isEmpty() const;
+  SqlLiteral literal(std::size_t i, const ISqlDialect &dialect) const;
+
+  // opaque url-safe string for the next page request
+  std::string token() const;
+  // false if token is malformed, cursor is empty then
+  bool parse(const std::string &token);
+
+private:
+  std::vector<char> m_types; // 'i' - integer, 'r' - real, 't' - text
+  std::vector<std::string> m_values;
 };
 
 class SqlBuilder;
@@ -70,6 +761,8 @@ class SqlInsert;
 class SqlUpdate;
 class SqlSelect;
 class SqlDelete;
+class SqlCopy;
+class SqlUpdateBatch;
 template<class T> class SqlWhere;
 
 class ISqlBuilder {
@@ -98,12 +791,53 @@ public:
   SqlBuilder &builder();
   SqlBuilder *builderRawPtr();
   const std::string &tableName();
+  const ISqlDialect &dialect() const;
   virtual std::string sql() = 0;
+  // one query can be rendered to several statements (for example chunks of multi-row insert)
+  virtual std::vector<std::string> statements();
+
+  // 64-bit FNV-1a hash of the query shape (statement type, table, columns,
+  // operators and sub-condition nesting), literal values are not included
+  virtual uint64_t fingerprint() const;
+  bool hasReturning() const;
+  bool hasWith() const;
+  // the query table or joined one
+  virtual bool hasTable(const std::string &tableName) const;
+
+protected:
+  template<class T> friend class SqlWhere;
+  void addError(const std::string &err);
+  // SQLite 3.35+ and PostgreSQL
+  void addReturning(const std::vector<std::string> &cols);
+  std::string returningClause();
+  // sql of the query is taken at once, so it must be finished before
+  void addWith(const std::string &name, SqlQuery &query);
+  // with trailing space or empty
+  std::string withClause();
+
+  // only in debug builds, so release builds have no per-call cost
+  template<class TColumn>
+  void checkColumnTable() {
+    static_assert(SqlIsColumnDef<TColumn>::value, "Expected column declared by SqlColumnDef");
+#ifndef NDEBUG
+    if (!hasTable(TColumn::table_type::name)) {
+      addError(
+        "Column '" + std::string(TColumn::name) + "' belongs to table '"
+        + std::string(TColumn::table_type::name) + "', but query for '" + tableName() + "'"
+      );
+    }
+#endif
+  }
+
+  void mixFingerprint(SqlFingerprintToken token, const std::string &value = "", int depth = 0);
 
 private:
   SqlQueryType m_sqlType;
   std::string m_tableName;
   SqlBuilder *m_builder;
+  uint64_t m_fingerprint;
+  std::vector<std::string> m_returning;
+  std::vector<std::pair<std::string, std::string>> m_with;
 };
 
 class SqlWhereBase {
@@ -111,6 +845,10 @@ public:
   SqlWhereBase(SqlWhereType type);
   SqlWhereType type();
   virtual std::string sql() = 0;
+  // names of columns used in conditions
+  virtual void columns(std::vector<std::string> &names);
+  // columns read inside of subqueries are not known by columns()
+  virtual bool hasSubqueries();
 
 private:
   SqlWhereType m_type;
@@ -130,19 +868,39 @@ public:
 
 class SqlWhereCondition : public SqlWhereBase {
 public:
+  // value is already formatted by dialect of the query
+  SqlWhereCondition(const std::string &name, SqlWhereConditionType comparator, const SqlLiteral &value);
+  // raw values, strings are escaped as for MySQL whatever the database is
+  [[deprecated("use SqlLiteral formatted by the dialect of the query")]]
   SqlWhereCondition(const std::string &name, SqlWhereConditionType comparator, const std::string &value);
+  [[deprecated("use SqlLiteral formatted by the dialect of the query")]]
   SqlWhereCondition(const std::string &name, SqlWhereConditionType comparator, int value);
+  [[deprecated("use SqlLiteral formatted by the dialect of the query")]]
   SqlWhereCondition(const std::string &name, SqlWhereConditionType comparator, long value);
+  [[deprecated("use SqlLiteral formatted by the dialect of the query")]]
   SqlWhereCondition(const std::string &name, SqlWhereConditionType comparator, double value);
+  [[deprecated("use SqlLiteral formatted by the dialect of the query")]]
   SqlWhereCondition(const std::string &name, SqlWhereConditionType comparator, float value);
+  // IN_ARRAY and NOT_IN_ARRAY are rendered by the dialect, value is array literal
+  SqlWhereCondition(const std::string &name, SqlWhereConditionType comparator, const SqlLiteral &value, const ISqlDialect &dialect);
   const std::string &name();
   SqlWhereConditionType comparator();
   const std::string &value();
   virtual std::string sql() override;
+  virtual void columns(std::vector<std::string> &names) override;
+  // value is a subquery (inSelect, exists)
+  void setSubquery(bool subquery);
+  virtual bool hasSubqueries() override;
+  // count of values of 'IN (...)' list, 0 for other conditions
+  void setListSize(std::size_t size);
+  std::size_t listSize();
 private:
   std::string m_name;
   std::string m_value;
   SqlWhereConditionType m_comparator;
+  bool m_subquery = false;
+  std::size_t m_listSize = 0;
+  const ISqlDialect *m_dialect = nullptr;
 };
 
 class SqlSelect;
@@ -151,7 +909,9 @@ template<class T>
 class SqlWhere : public SqlWhereBase {
 public:
   SqlWhere(SqlWhere<T> *parent, SqlBuilder *builder, T *query)
-    : SqlWhereBase(SqlWhereType::SUB_CONDITION), m_parent(parent), m_builder(builder), m_query(query) { }
+    : SqlWhereBase(SqlWhereType::SUB_CONDITION), m_parent(parent), m_builder(builder), m_query(query) {
+    m_depth = m_parent != nullptr ? m_parent->m_depth + 1 : 0;
+  }
 
   template <typename TVal>
   SqlWhere<T> &notEqual(const std::string &name, TVal value) {
@@ -177,11 +937,111 @@ public:
     return *this;
   }
 
+  template <typename TVal>
+  SqlWhere<T> &moreOrEqual(const std::string &name, TVal value) {
+    cond(name, SqlWhereConditionType::MORE_OR_EQUAL, value);
+    return *this;
+  }
+
+  template <typename TVal>
+  SqlWhere<T> &lessOrEqual(const std::string &name, TVal value) {
+    cond(name, SqlWhereConditionType::LESS_OR_EQUAL, value);
+    return *this;
+  }
+
   SqlWhere<T> &like(const std::string &name, const std::string &value) {
     cond(name, SqlWhereConditionType::LIKE, value);
     return *this;
   }
 
+  // Subqueries are rendered when they are added, so they must be finished before:
+  //   name IN (SELECT ...), EXISTS (SELECT ...)
+  SqlWhere<T> &inSelect(const std::string &name, SqlQuery &select) {
+    return condSubquery(name, SqlWhereConditionType::IN, select);
+  }
+
+  SqlWhere<T> &notInSelect(const std::string &name, SqlQuery &select) {
+    return condSubquery(name, SqlWhereConditionType::NOT_IN, select);
+  }
+
+  SqlWhere<T> &exists(SqlQuery &select) {
+    return condSubquery("", SqlWhereConditionType::EXISTS, select);
+  }
+
+  SqlWhere<T> &notExists(SqlQuery &select) {
+    return condSubquery("", SqlWhereConditionType::NOT_EXISTS, select);
+  }
+
+  // compare with other column (not a value): o.user_id = u.id
+  SqlWhere<T> &equalColum(const std::string &name, const std::string &otherName) {
+    cond(name, SqlWhereConditionType::EQUAL, SqlLiteral(otherName));
+    // the other column is a part of shape
+    m_query->mixFingerprint(SqlFingerprintToken::COLUMN, otherName, m_depth);
+    return *this;
+  }
+
+  template <class TColumn, typename TVal>
+  SqlWhere<T> &notEqual(const TVal &value) {
+    m_query->template checkColumnTable<TColumn>();
+    return cond(TColumn::name, SqlWhereConditionType::NOT_EQUAL, TColumn::literal(m_query->dialect(), value));
+  }
+
+  template <class TColumn, typename TVal>
+  SqlWhere<T> &equal(const TVal &value) {
+    m_query->template checkColumnTable<TColumn>();
+    return cond(TColumn::name, SqlWhereConditionType::EQUAL, TColumn::literal(m_query->dialect(), value));
+  }
+
+  template <class TColumn, typename TVal>
+  SqlWhere<T> &moreThen(const TVal &value) {
+    m_query->template checkColumnTable<TColumn>();
+    return cond(TColumn::name, SqlWhereConditionType::MORE_THEN, TColumn::literal(m_query->dialect(), value));
+  }
+
+  template <class TColumn, typename TVal>
+  SqlWhere<T> &lessThen(const TVal &value) {
+    m_query->template checkColumnTable<TColumn>();
+    return cond(TColumn::name, SqlWhereConditionType::LESS_THEN, TColumn::literal(m_query->dialect(), value));
+  }
+
+  template <class TColumn>
+  SqlWhere<T> &like(const std::string &value) {
+    m_query->template checkColumnTable<TColumn>();
+    static_assert(std::is_same<typename TColumn::value_type, std::string>::value, "like() allowed only for text columns");
+    return cond(TColumn::name, SqlWhereConditionType::LIKE, TColumn::literal(m_query->dialect(), value));
+  }
+
+  // values are already formatted, rendered as: name IN (v1, v2)
+  SqlWhere<T> &in(const std::string &name, const std::vector<SqlLiteral> &values) {
+    return inList(name, SqlWhereConditionType::IN, values, 0);
+  }
+
+  // Values are sorted and duplicates removed. Long lists are split by chunkSize
+  // (by default maxVariables of the dialect): (name IN (..) OR name IN (..))
+  template <class TRange>
+  SqlWhere<T> &in(const std::string &name, const TRange &values, std::size_t chunkSize = 0) {
+    return inList(name, SqlWhereConditionType::IN, sortedLiterals(values), chunkSize);
+  }
+
+  template <class TRange>
+  SqlWhere<T> &notIn(const std::string &name, const TRange &values, std::size_t chunkSize = 0) {
+    return inList(name, SqlWhereConditionType::NOT_IN, sortedLiterals(values), chunkSize);
+  }
+
+  // The same statement for any count of values (one array literal), so prepared plans can be reused:
+  //   SQLite: name IN (SELECT value FROM json_each('[1,2]'))
+  //   PostgreSQL: name = ANY('{1,2}')
+  //   MySQL 8.0.17+: name MEMBER OF('[1,2]')
+  template <class TRange>
+  SqlWhere<T> &inArray(const std::string &name, const TRange &values) {
+    return condArray(name, SqlWhereConditionType::IN_ARRAY, values);
+  }
+
+  template <class TRange>
+  SqlWhere<T> &notInArray(const std::string &name, const TRange &values) {
+    return condArray(name, SqlWhereConditionType::NOT_IN_ARRAY, values);
+  }
+
   SqlWhere<T> &or_() {
     if (
       m_conditions.size() > 0
@@ -192,6 +1052,7 @@ public:
     }
 
     m_conditions.push_back(std::make_shared<SqlWhereOr>());
+    m_query->mixFingerprint(SqlFingerprintToken::LOGICAL_OR, "", m_depth);
     return *this;
   }
 
@@ -204,18 +1065,21 @@ public:
       return *this;
     }
     m_conditions.push_back(std::make_shared<SqlWhereAnd>());
+    m_query->mixFingerprint(SqlFingerprintToken::LOGICAL_AND, "", m_depth);
     return *this;
   }
 
   SqlWhere<T> &subCondition() {
     if (
       m_conditions.size() > 0
-      && m_conditions[m_conditions.size()-1]->type() == SqlWhereType::CONDITION
+      && (m_conditions[m_conditions.size()-1]->type() == SqlWhereType::CONDITION
+        || m_conditions[m_conditions.size()-1]->type() == SqlWhereType::SUB_CONDITION)
     ) {
         and_(); // default add and_
     }
     auto sub_cond = std::make_shared<SqlWhere<T>>(this, m_builder, m_query);
     m_conditions.push_back(sub_cond);
+    m_query->mixFingerprint(SqlFingerprintToken::SUB_CONDITION, "", m_depth);
     return *(sub_cond.get());
   }
 
@@ -233,6 +1097,99 @@ public:
     return *m_query;
   }
 
+  const std::vector<std::shared_ptr<SqlWhereBase>> &conditions() {
+    return m_conditions;
+  }
+
+  virtual void columns(std::vector<std::string> &names) override {
+    for (auto item : m_conditions) {
+      item->columns(names);
+    }
+  }
+
+  virtual bool hasSubqueries() override {
+    for (auto item : m_conditions) {
+      if (item->hasSubqueries()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Optional pass before rendering (see SqlBuilder::simplify), a changed tree is mixed into the fingerprint.
+  // Returns false if conditions are always false, they are replaced by '1 = 0' then.
+  bool simplify(SqlSimplifyReport &report) {
+    SqlSimplifyReport before = report;
+    std::string shapeBefore = shape();
+    bool ret = simplifyConditions(report);
+    std::string shapeAfter = shape();
+    if (shapeAfter != shapeBefore) {
+      // the same shape before can give different results, like 'x = 1 AND x = 1' and 'x = 1 AND x = 2'
+      m_query->mixFingerprint(
+        SqlFingerprintToken::SIMPLIFIED,
+        shapeAfter
+          + " " + std::to_string(report.flattenedGroups - before.flattenedGroups)
+          + " " + std::to_string(report.removedDuplicates - before.removedDuplicates)
+          + " " + std::to_string(report.rewrittenToIn - before.rewrittenToIn)
+          + " " + std::to_string(report.contradictions - before.contradictions),
+        m_depth
+      );
+    }
+    return ret;
+  }
+
+  // Optional pass (see SqlBuilder::rewriteSargable), every rewrite is added to report and to the fingerprint
+  void rewriteSargable(const ISqlDialect &dialect, SqlRewriteReport &report) {
+    std::vector<std::shared_ptr<SqlWhereBase>> conditions;
+    for (auto item : m_conditions) {
+      if (item->type() == SqlWhereType::SUB_CONDITION) {
+        std::static_pointer_cast<SqlWhere<T>>(item)->rewriteSargable(dialect, report);
+      }
+      if (item->type() != SqlWhereType::CONDITION) {
+        conditions.push_back(item);
+        continue;
+      }
+      auto cond = std::static_pointer_cast<SqlWhereCondition>(item);
+
+      // col LIKE 'abc%' -> col >= 'abc' AND col < 'abd', AND has higher priority, so no parentheses
+      std::string prefix;
+      if (
+        cond->comparator() == SqlWhereConditionType::LIKE
+        && dialect.likePrefixRange()
+        && SqlBuilderHelpers::likePrefix(cond->value(), prefix)
+      ) {
+        std::string upper = prefix;
+        upper[upper.size() - 1]++;
+        auto from = std::make_shared<SqlWhereCondition>(
+          cond->name(), SqlWhereConditionType::MORE_OR_EQUAL, SqlLiteral(dialect.escapeString(prefix)));
+        auto to = std::make_shared<SqlWhereCondition>(
+          cond->name(), SqlWhereConditionType::LESS_THEN, SqlLiteral(dialect.escapeString(upper)));
+        conditions.push_back(from);
+        conditions.push_back(std::make_shared<SqlWhereAnd>());
+        conditions.push_back(to);
+        report.rewrites.push_back(cond->sql() + " -> " + from->sql() + " AND " + to->sql());
+        mixRewrite(cond, {from, to});
+        continue;
+      }
+
+      // 10 < age -> age > 10
+      SqlWhereConditionType flipped;
+      if (
+        SqlBuilderHelpers::isValueLiteral(cond->name())
+        && SqlBuilderHelpers::isColumnName(cond->value())
+        && flipComparator(cond->comparator(), flipped)
+      ) {
+        auto swapped = std::make_shared<SqlWhereCondition>(cond->value(), flipped, SqlLiteral(cond->name()));
+        conditions.push_back(swapped);
+        report.rewrites.push_back(cond->sql() + " -> " + swapped->sql());
+        mixRewrite(cond, {swapped});
+        continue;
+      }
+      conditions.push_back(item);
+    }
+    m_conditions = conditions;
+  }
+
   virtual std::string sql() override {
     std::string ret = "";
     for (auto item : m_conditions) {
@@ -246,45 +1203,501 @@ public:
   }
 
 private:
+  template <typename TVal>
+  SqlLiteral literal(const TVal &value) {
+    if constexpr (std::is_same<TVal, SqlLiteral>::value) {
+      return value;
+    } else if constexpr (std::is_convertible<TVal, std::string>::value) {
+      return SqlLiteral(m_query->dialect().escapeString(value));
+    } else {
+      return SqlLiteral(SqlBuilderHelpers::formatValue(value));
+    }
+  }
+
   template <typename TVal>
   SqlWhere<T> &cond(const std::string &name, SqlWhereConditionType comparator, TVal value) {
+    return addCondition(std::make_shared<SqlWhereCondition>(name, comparator, literal(value)));
+  }
+
+  SqlWhere<T> &addCondition(const std::shared_ptr<SqlWhereCondition> &condition) {
     if (
       m_conditions.size() > 0
-      && m_conditions[m_conditions.size()-1]->type() == SqlWhereType::CONDITION
+      && (m_conditions[m_conditions.size()-1]->type() == SqlWhereType::CONDITION
+        || m_conditions[m_conditions.size()-1]->type() == SqlWhereType::SUB_CONDITION)
     ) {
         and_(); // default add and_
     }
-    m_conditions.push_back(std::make_shared<SqlWhereCondition>(name, comparator, value));
+    m_conditions.push_back(condition);
+    // 'col IS NULL' has other shape than 'col = 5'
+    bool isNull = condition->value() == "NULL";
+    m_query->mixFingerprint(
+      SqlFingerprintToken::CONDITION,
+      condition->name() + " " + std::to_string(static_cast<int>(condition->comparator())) + (isNull ? " NULL" : ""),
+      m_depth
+    );
     return *this;
   }
 
-  void addError(const std::string &err) {
-    ((ISqlBuilder *)m_builder)->addError(err);
+  // rewritten condition has other shape, the same shape before can be rewritten or not ('abc%' and 'a%c')
+  void mixRewrite(
+    const std::shared_ptr<SqlWhereCondition> &condition,
+    const std::vector<std::shared_ptr<SqlWhereCondition>> &rewritten
+  ) {
+    std::string shape = condition->name() + " " + std::to_string(static_cast<int>(condition->comparator())) + " ->";
+    for (auto item : rewritten) {
+      shape += " " + item->name() + " " + std::to_string(static_cast<int>(item->comparator()));
+    }
+    m_query->mixFingerprint(SqlFingerprintToken::REWRITTEN, shape, m_depth);
   }
 
-  SqlBuilder *m_builder;
-  T *m_query;
-  SqlWhere<T> *m_parent;
+  static bool flipComparator(SqlWhereConditionType comparator, SqlWhereConditionType &flipped) {
+    switch (comparator) {
+      case SqlWhereConditionType::EQUAL:
+      case SqlWhereConditionType::NOT_EQUAL:
+        flipped = comparator;
+        return true;
+      case SqlWhereConditionType::MORE_THEN:
+        flipped = SqlWhereConditionType::LESS_THEN;
+        return true;
+      case SqlWhereConditionType::LESS_THEN:
+        flipped = SqlWhereConditionType::MORE_THEN;
+        return true;
+      case SqlWhereConditionType::MORE_OR_EQUAL:
+        flipped = SqlWhereConditionType::LESS_OR_EQUAL;
+        return true;
+      case SqlWhereConditionType::LESS_OR_EQUAL:
+        flipped = SqlWhereConditionType::MORE_OR_EQUAL;
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  // 'name comparator' of conditions with operators and parentheses, without values
+  std::string shape() {
+    std::string ret;
+    for (auto item : m_conditions) {
+      if (item->type() == SqlWhereType::SUB_CONDITION) {
+        ret += "(" + std::static_pointer_cast<SqlWhere<T>>(item)->shape() + ")";
+      } else if (item->type() == SqlWhereType::LOGICAL_OPERATOR) {
+        ret += dynamic_cast<SqlWhereOr *>(item.get()) != nullptr ? " OR " : " AND ";
+      } else {
+        auto cond = std::static_pointer_cast<SqlWhereCondition>(item);
+        ret += cond->name() + " " + std::to_string(static_cast<int>(cond->comparator()));
+        ret += cond->value() == "NULL" ? " NULL" : "";
+      }
+    }
+    return ret;
+  }
+
+  bool simplifyConditions(SqlSimplifyReport &report) {
+    std::vector<std::vector<std::shared_ptr<SqlWhereBase>>> groups;
+    if (!orGroups(groups)) {
+      return true; // empty or malformed, keep as is
+    }
+
+    std::vector<std::vector<std::shared_ptr<SqlWhereBase>>> result;
+    for (auto &group : groups) {
+      std::vector<std::shared_ptr<SqlWhereBase>> terms;
+      if (!simplifyGroup(group, terms, report)) {
+        continue;
+      }
+      // x OR (a OR b)
+      if (terms.size() == 1 && terms[0]->type() == SqlWhereType::SUB_CONDITION) {
+        std::vector<std::vector<std::shared_ptr<SqlWhereBase>>> subGroups;
+        if (std::static_pointer_cast<SqlWhere<T>>(terms[0])->orGroups(subGroups)) {
+          report.flattenedGroups++;
+          result.insert(result.end(), subGroups.begin(), subGroups.end());
+          continue;
+        }
+      }
+      result.push_back(terms);
+    }
+
+    if (result.size() == 0) {
+      m_conditions.clear();
+      m_conditions.push_back(std::make_shared<SqlWhereCondition>("1", SqlWhereConditionType::EQUAL, SqlLiteral("0")));
+      return false;
+    }
+
+    // the same groups in OR
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < result.size(); i++) {
+      std::string key;
+      for (auto term : result[i]) {
+        key += term->sql() + "\n";
+      }
+      if (std::find(keys.begin(), keys.end(), key) != keys.end()) {
+        report.removedDuplicates++;
+        result.erase(result.begin() + i);
+        i--;
+      } else {
+        keys.push_back(key);
+      }
+    }
+
+    rewriteToIn(result, report);
+
+    m_conditions.clear();
+    for (std::size_t i = 0; i < result.size(); i++) {
+      if (i > 0) {
+        m_conditions.push_back(std::make_shared<SqlWhereOr>());
+      }
+      for (std::size_t j = 0; j < result[i].size(); j++) {
+        if (j > 0) {
+          m_conditions.push_back(std::make_shared<SqlWhereAnd>());
+        }
+        if (result[i][j]->type() == SqlWhereType::SUB_CONDITION) {
+          std::static_pointer_cast<SqlWhere<T>>(result[i][j])->m_parent = this;
+        }
+        m_conditions.push_back(result[i][j]);
+      }
+    }
+    return true;
+  }
+
+  // AND has higher priority: a AND b OR c -> {{a, b}, {c}}
+  bool orGroups(std::vector<std::vector<std::shared_ptr<SqlWhereBase>>> &groups) {
+    groups.clear();
+    groups.emplace_back();
+    bool expectTerm = true;
+    for (auto item : m_conditions) {
+      bool isTerm = item->type() != SqlWhereType::LOGICAL_OPERATOR;
+      if (isTerm != expectTerm) {
+        return false;
+      }
+      if (isTerm) {
+        groups.back().push_back(item);
+      } else if (dynamic_cast<SqlWhereOr *>(item.get()) != nullptr) {
+        groups.emplace_back();
+      }
+      expectTerm = !isTerm;
+    }
+    return m_conditions.size() > 0 && !expectTerm;
+  }
+
+  // returns false if terms of AND are always false
+  bool simplifyGroup(
+    const std::vector<std::shared_ptr<SqlWhereBase>> &group,
+    std::vector<std::shared_ptr<SqlWhereBase>> &terms,
+    SqlSimplifyReport &report
+  ) {
+    for (auto item : group) {
+      if (item->type() != SqlWhereType::SUB_CONDITION) {
+        terms.push_back(item);
+        continue;
+      }
+      auto sub = std::static_pointer_cast<SqlWhere<T>>(item);
+      if (sub->m_conditions.size() == 0) {
+        report.flattenedGroups++; // '()'
+        continue;
+      }
+      if (!sub->simplifyConditions(report)) {
+        return false; // already counted in the sub condition
+      }
+      // a AND (b AND c), (a)
+      std::vector<std::vector<std::shared_ptr<SqlWhereBase>>> subGroups;
+      if (sub->orGroups(subGroups) && subGroups.size() == 1) {
+        report.flattenedGroups++;
+        terms.insert(terms.end(), subGroups[0].begin(), subGroups[0].end());
+        continue;
+      }
+      terms.push_back(item);
+    }
+
+    std::vector<std::string> sqls;
+    for (std::size_t i = 0; i < terms.size(); i++) {
+      std::string sql = terms[i]->sql();
+      if (std::find(sqls.begin(), sqls.end(), sql) != sqls.end()) {
+        report.removedDuplicates++;
+        terms.erase(terms.begin() + i);
+        i--;
+      } else {
+        sqls.push_back(sql);
+      }
+    }
+
+    for (std::size_t i = 0; i < terms.size(); i++) {
+      for (std::size_t j = i + 1; j < terms.size(); j++) {
+        if (contradicts(terms[i], terms[j])) {
+          report.contradictions++;
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  // 'x = 1 AND x = 2', 'x = 1 AND x <> 1', 'x IS NULL AND x = 1'.
+  // Strings are not compared: they can be equal by collation of the column ('a' and 'A').
+  static bool contradicts(const std::shared_ptr<SqlWhereBase> &item1, const std::shared_ptr<SqlWhereBase> &item2) {
+    if (item1->type() != SqlWhereType::CONDITION || item2->type() != SqlWhereType::CONDITION) {
+      return false;
+    }
+    auto cond1 = std::static_pointer_cast<SqlWhereCondition>(item1);
+    auto cond2 = std::static_pointer_cast<SqlWhereCondition>(item2);
+    if (cond1->name() != cond2->name()) {
+      return false;
+    }
+    SqlWhereConditionType cmp1 = cond1->comparator();
+    SqlWhereConditionType cmp2 = cond2->comparator();
+    if (cmp1 == SqlWhereConditionType::EQUAL && cmp2 == SqlWhereConditionType::EQUAL) {
+      return SqlBuilderHelpers::differentValues(cond1->value(), cond2->value());
+    }
+    bool equalAndNot = (cmp1 == SqlWhereConditionType::EQUAL && cmp2 == SqlWhereConditionType::NOT_EQUAL)
+      || (cmp1 == SqlWhereConditionType::NOT_EQUAL && cmp2 == SqlWhereConditionType::EQUAL);
+    return equalAndNot && cond1->value() == cond2->value();
+  }
+
+  // groups with only 'x = value' for the same column -> one 'x IN (...)'
+  static void rewriteToIn(std::vector<std::vector<std::shared_ptr<SqlWhereBase>>> &groups, SqlSimplifyReport &report) {
+    std::vector<std::string> names;
+    std::vector<std::vector<std::size_t>> indexes;
+    for (std::size_t i = 0; i < groups.size(); i++) {
+      if (groups[i].size() != 1 || groups[i][0]->type() != SqlWhereType::CONDITION) {
+        continue;
+      }
+      auto cond = std::static_pointer_cast<SqlWhereCondition>(groups[i][0]);
+      if (cond->comparator() != SqlWhereConditionType::EQUAL || cond->value() == "NULL") {
+        continue;
+      }
+      auto it = std::find(names.begin(), names.end(), cond->name());
+      if (it == names.end()) {
+        names.push_back(cond->name());
+        indexes.push_back({i});
+      } else {
+        indexes[it - names.begin()].push_back(i);
+      }
+    }
+
+    std::vector<bool> removed(groups.size(), false);
+    for (std::size_t n = 0; n < names.size(); n++) {
+      if (indexes[n].size() < 2) {
+        continue;
+      }
+      std::string values;
+      for (std::size_t i : indexes[n]) {
+        values += (values.empty() ? "" : ", ") + std::static_pointer_cast<SqlWhereCondition>(groups[i][0])->value();
+        removed[i] = true;
+      }
+      std::size_t first = indexes[n][0];
+      auto list = std::make_shared<SqlWhereCondition>(names[n], SqlWhereConditionType::IN, SqlLiteral("(" + values + ")"));
+      list->setListSize(indexes[n].size());
+      groups[first][0] = list;
+      removed[first] = false;
+      report.rewrittenToIn++;
+    }
+    for (std::size_t i = groups.size(); i > 0; i--) {
+      if (removed[i - 1]) {
+        groups.erase(groups.begin() + (i - 1));
+      }
+    }
+  }
+
+  SqlWhere<T> &condSubquery(const std::string &name, SqlWhereConditionType comparator, SqlQuery &select) {
+    auto condition = std::make_shared<SqlWhereCondition>(name, comparator, SqlLiteral("(" + select.sql() + ")"));
+    condition->setSubquery(true);
+    addCondition(condition);
+    m_query->mixFingerprint(SqlFingerprintToken::SUBQUERY, std::to_string(select.fingerprint()), m_depth);
+    return *this;
+  }
+
+  template <class TRange>
+  static auto sortedValues(const TRange &values) {
+    using TItem = typename std::decay<decltype(*std::begin(values))>::type;
+    using TValue = typename std::conditional<std::is_convertible<TItem, std::string>::value, std::string, TItem>::type;
+    std::vector<TValue> ret(std::begin(values), std::end(values));
+    std::sort(ret.begin(), ret.end());
+    ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+    return ret;
+  }
+
+  template <class TRange>
+  std::vector<SqlLiteral> sortedLiterals(const TRange &values) {
+    std::vector<SqlLiteral> ret;
+    for (const auto &value : sortedValues(values)) {
+      ret.push_back(literal(value));
+    }
+    return ret;
+  }
+
+  SqlWhere<T> &inList(
+    const std::string &name, SqlWhereConditionType comparator,
+    const std::vector<SqlLiteral> &values, std::size_t chunkSize
+  ) {
+    if (chunkSize == 0) {
+      chunkSize = m_query->dialect().chunkLimits().maxVariables;
+    }
+    if (values.size() == 0) {
+      // rendered as '1 = 0' or '1 = 1', other shape than a list of values
+      condList(name, comparator, values, 0, 0);
+      m_query->mixFingerprint(SqlFingerprintToken::EMPTY_LIST, "", m_depth);
+      return *this;
+    }
+    if (chunkSize == 0 || values.size() <= chunkSize) {
+      return condList(name, comparator, values, 0, values.size());
+    }
+    SqlWhere<T> &sub = subCondition();
+    for (std::size_t i = 0; i < values.size(); i += chunkSize) {
+      if (i > 0 && comparator == SqlWhereConditionType::IN) {
+        sub.or_();
+      }
+      std::size_t end = std::min(values.size(), i + chunkSize);
+      sub.condList(name, comparator, values, i, end);
+    }
+    return *this;
+  }
+
+  SqlWhere<T> &condList(
+    const std::string &name, SqlWhereConditionType comparator,
+    const std::vector<SqlLiteral> &values, std::size_t begin, std::size_t end
+  ) {
+    auto condition = std::make_shared<SqlWhereCondition>(name, comparator, SqlLiteral(valuesList(values, begin, end)));
+    condition->setListSize(end - begin);
+    return addCondition(condition);
+  }
+
+  static std::string valuesList(const std::vector<SqlLiteral> &values, std::size_t begin, std::size_t end) {
+    std::string ret = "(";
+    for (std::size_t i = begin; i < end; i++) {
+      if (i > begin) {
+        ret += ", ";
+      }
+      ret += values[i].sql();
+    }
+    return ret + ")";
+  }
+
+  template <class TRange>
+  SqlWhere<T> &condArray(const std::string &name, SqlWhereConditionType comparator, const TRange &values) {
+    std::vector<std::string> items;
+    bool strings = false;
+    for (const auto &value : sortedValues(values)) {
+      if constexpr (std::is_convertible<decltype(value), std::string>::value) {
+        items.push_back(value);
+        strings = true;
+      } else {
+        items.push_back(SqlBuilderHelpers::formatValue(value));
+      }
+    }
+    const ISqlDialect &dialect = m_query->dialect();
+    SqlLiteral value(dialect.escapeString(dialect.arrayLiteral(items, strings)));
+    return addCondition(std::make_shared<SqlWhereCondition>(name, comparator, value, dialect));
+  }
+
+  void addError(const std::string &err) {
+    ((ISqlBuilder *)m_builder)->addError(err);
+  }
+
+  SqlBuilder *m_builder;
+  T *m_query;
+  SqlWhere<T> *m_parent;
+  int m_depth;
   std::vector<std::shared_ptr<SqlWhereBase>> m_conditions;
 };
 
+class SqlSelectJoin {
+public:
+  SqlJoinType type;
+  std::string tableName;
+  std::string alias;
+  std::shared_ptr<SqlWhere<SqlSelect>> on;
+};
+
 class SqlSelect : public SqlQuery {
 public:
   SqlSelect(const std::string &tableName, SqlBuilder *builder);
+  // WITH name AS (SELECT ...) SELECT ...
+  SqlSelect &with(const std::string &name, SqlQuery &select);
+  // FROM users AS u
+  SqlSelect &as(const std::string &alias);
+  // ON conditions, endWhere() returns to the select:
+  //   .innerJoin("orders", "o").equalColum("o.user_id", "u.id").endWhere()
+  SqlWhere<SqlSelect> &innerJoin(const std::string &tableName, const std::string &alias = "");
+  SqlWhere<SqlSelect> &leftJoin(const std::string &tableName, const std::string &alias = "");
   SqlSelect &colum(const std::string &col, const std::string &col_as = "");
 
+  template<class TColumn>
+  SqlSelect &colum(const std::string &col_as = "") {
+    checkColumnTable<TColumn>();
+    return colum(TColumn::name, col_as);
+  }
+
+  // aggregates: COUNT(*) AS cnt
+  SqlSelect &count(const std::string &col = "*", const std::string &col_as = "");
+  SqlSelect &sum(const std::string &col, const std::string &col_as = "");
+  SqlSelect &min(const std::string &col, const std::string &col_as = "");
+  SqlSelect &max(const std::string &col, const std::string &col_as = "");
+  SqlSelect &avg(const std::string &col, const std::string &col_as = "");
+
   SqlWhere<SqlSelect> &where();
-  // TODO group by
-  // TODO order by
+  SqlSelect &groupBy(const std::string &col);
+  // conditions for aggregates: having().moreThen("COUNT(*)", 10)
+  SqlWhere<SqlSelect> &having();
+  SqlSelect &orderBy(const std::string &col, bool descending = false);
+  // rendered by dialect (LIMIT n OFFSET m or LIMIT m, n), negative means not defined
+  SqlSelect &limit(long limit);
+  SqlSelect &offset(long offset);
+
+  // Keyset (seek) pagination, the page starts after the cursor (empty cursor - the first page):
+  //   WHERE (a, b) > (1, 'x') ORDER BY a, b LIMIT 100
+  // Without row values comparison in the dialect: WHERE a >= 1 AND (a > 1 OR (a = 1 AND b > 'x'))
+  SqlSelect &keyset(
+    const std::vector<std::string> &keyColumns,
+    long pageSize,
+    const SqlKeysetCursor &after = SqlKeysetCursor(),
+    bool descending = false
+  );
+  SqlSelect &keyset(
+    const std::vector<std::string> &keyColumns,
+    long pageSize,
+    const std::string &afterToken,
+    bool descending = false
+  );
+
+  // token for the next page by key values of the last row
+  template<typename... TVals>
+  std::string nextCursor(const TVals &...lastRowKeys) {
+    if (sizeof...(lastRowKeys) != m_keysetColumns.size()) {
+      addError("SqlSelect. Expected " + std::to_string(m_keysetColumns.size()) + " key values for cursor of '" + tableName() + "'");
+      return "";
+    }
+    return SqlKeysetCursor::of(lastRowKeys...).token();
+  }
+
   virtual std::string sql() override;
+  virtual bool hasTable(const std::string &tableName) const override;
 
 private:
+  friend class SqlInsert;
+  friend class SqlBuilder;
+  std::string keysetCondition();
+  std::string orderByClause();
+
+  SqlWhere<SqlSelect> &join(SqlJoinType type, const std::string &tableName, const std::string &alias);
+
+  std::string m_alias;
+  std::vector<SqlSelectJoin> m_joins;
   std::shared_ptr<SqlWhere<SqlSelect>> m_where;
+  std::shared_ptr<SqlWhere<SqlSelect>> m_having;
+  std::vector<std::string> m_groupBy;
+  std::vector<std::pair<std::string, bool>> m_orderBy;
+  long m_offset;
   std::vector<std::string> m_columns;
   std::map<std::string, std::string> m_columns_as;
+  std::vector<std::string> m_keysetColumns;
+  std::vector<SqlLiteral> m_keysetValues;
+  bool m_keysetDescending;
+  long m_limit;
 };
 
 
+class ISqlStatementSink {
+public:
+  virtual ~ISqlStatementSink() { }
+  virtual void write(const std::string &statement) = 0;
+};
+
 class SqlInsert : public SqlQuery {
 public:
   SqlInsert(const std::string &tableName, SqlBuilder *builder);
@@ -292,17 +1705,135 @@ public:
   SqlInsert &addColums(const std::vector<std::string> &cols);
   SqlInsert &clearValues();
 
+  // finish current row, next values will be added to the new one
+  SqlInsert &newRow();
+  template<typename... TVals>
+  SqlInsert &row(const TVals &...vals) {
+    newRow();
+    (val(vals), ...);
+    return newRow();
+  }
+  std::size_t rowsCount();
+
+  // by default limits of the database dialect
+  SqlInsert &setChunkLimits(const SqlChunkLimits &limits);
+  SqlChunkLimits chunkLimits();
+
   SqlInsert &val(const std::string &val);
   SqlInsert &val(int val);
   SqlInsert &val(long val);
   SqlInsert &val(float val);
   SqlInsert &val(double val);
+  SqlInsert &val(const SqlLiteral &val);
+
+  template<class TColumn>
+  SqlInsert &colum() {
+    checkColumnTable<TColumn>();
+    return colum(TColumn::name);
+  }
+
+  template<class TColumn, typename TVal>
+  SqlInsert &val(const TVal &val) {
+    checkColumnTable<TColumn>();
+    return this->val(TColumn::literal(dialect(), val));
+  }
+
+  // new row, columns are taken from the mapping, if not defined yet
+  template<class T>
+  SqlInsert &object(const SqlRowMapping<T> &mapping, const T &obj) {
+    if (m_columns.size() == 0) {
+      addColums(mapping.columns());
+    } else if (m_columns.size() != mapping.size()) {
+      addError("SqlInsert. Count of columns is different from mapping for '" + mapping.tableName() + "'");
+      return *this;
+    }
+    newRow();
+    m_rowsData += "(";
+    for (std::size_t i = 0; i < mapping.size(); i++) {
+      if (i > 0) {
+        m_rowsData += ", ";
+      }
+      m_rowsData += mapping.literal(dialect(), i, obj).sql();
+    }
+    m_rowsData += ")";
+    m_rowsEnds.push_back(m_rowsData.size());
+    return *this;
+  }
 
+  template<class T, class TRange>
+  SqlInsert &objects(const SqlRowMapping<T> &mapping, const TRange &objs) {
+    for (const T &obj : objs) {
+      object(mapping, obj);
+    }
+    return *this;
+  }
+
+  // rows from column-wise data, columns are taken from it, if not defined yet
+  SqlInsert &bulk(const SqlBulkColumns &columns);
+
+  // ON CONFLICT(cols) DO NOTHING by default, MySQL uses ON DUPLICATE KEY UPDATE for any unique key.
+  // PostgreSQL does not allow to update the same row twice in one statement,
+  // so keys must be unique in multi-row insert with doUpdateSet()
+  SqlInsert &onConflict(const std::vector<std::string> &cols = {});
+  SqlInsert &doNothing();
+  // col = excluded.col, all inserted columns except conflict target if cols is empty
+  SqlInsert &doUpdateSet(const std::vector<std::string> &cols = {});
+  SqlInsert &returning(const std::vector<std::string> &cols);
+
+  // Rows are pulled from source until it returns false, full chunks are written to sink,
+  // so only one chunk is kept in memory. Returns count of written statements,
+  // the insert has no statements in the builder after that (except rows added later)
+  std::size_t stream(const std::function<bool(SqlInsert &)> &source, ISqlStatementSink &sink);
+
+  // any input range (also std::generator), objects are taken one by one
+  template<class T, class TRange>
+  std::size_t streamObjects(const SqlRowMapping<T> &mapping, TRange &&objs, ISqlStatementSink &sink) {
+    if (m_columns.size() == 0) {
+      addColums(mapping.columns());
+    }
+    auto it = std::begin(objs);
+    auto end = std::end(objs);
+    return stream([&](SqlInsert &insert) {
+      if (it == end) {
+        return false;
+      }
+      insert.object(mapping, *it);
+      ++it;
+      return true;
+    }, sink);
+  }
+
+  // INSERT INTO table(cols) SELECT ..., rows are copied by the database,
+  // values and rows of the insert are not used after that
+  SqlSelect &selectFrom(const std::string &tableName);
+
+  // number of rows is not a part of fingerprint
+  virtual uint64_t fingerprint() const override;
   virtual std::string sql() override;
+  virtual std::vector<std::string> statements() override;
 
 private:
+  static void renderRow(std::string &out, const std::vector<std::string> &values);
+  std::string_view finishedRow(std::size_t i) const;
+  std::string conflictClause();
+  std::string columnsHeader();
+  bool chunkFull(const SqlChunkLimits &limits, std::size_t rows, std::size_t size, std::size_t rowSize);
+  // statement from the first finished rows
+  std::string renderChunk(const std::string &header, const std::string &suffix, std::size_t rows);
+  void removeRows(std::size_t rows);
+  friend class SqlBuilder;
+
   std::vector<std::string> m_columns;
-  std::vector<std::string> m_values;
+  std::vector<std::string> m_values; // current row
+  std::string m_rowsData; // finished rows "(v1, v2)" one by one
+  std::vector<std::size_t> m_rowsEnds; // end offset of every finished row in m_rowsData
+  std::optional<SqlChunkLimits> m_chunkLimits;
+  bool m_onConflict;
+  bool m_conflictDoUpdate;
+  std::vector<std::string> m_conflictColumns;
+  std::vector<std::string> m_conflictUpdateColumns;
+  std::shared_ptr<SqlSelect> m_select;
+  bool m_streamed;
 };
 
 class SqlUpdate : public SqlQuery {
@@ -314,61 +1845,1024 @@ public:
   SqlUpdate &set(const std::string &name, long val);
   SqlUpdate &set(const std::string &name, float val);
   SqlUpdate &set(const std::string &name, double val);
+  SqlUpdate &set(const std::string &name, const SqlLiteral &val);
+
+  template<class TColumn, typename TVal>
+  SqlUpdate &set(const TVal &val) {
+    checkColumnTable<TColumn>();
+    return set(TColumn::name, TColumn::literal(dialect(), val));
+  }
+
+  // set all fields and find the row by primary key fields
+  template<class T>
+  SqlUpdate &object(const SqlRowMapping<T> &mapping, const T &obj) {
+    if (!mapping.hasPrimaryKey()) {
+      addError("SqlUpdate. Mapping for '" + mapping.tableName() + "' has no primary key");
+      return *this;
+    }
+    for (std::size_t i = 0; i < mapping.size(); i++) {
+      if (!mapping.isPrimaryKey(i)) {
+        set(mapping.name(i), mapping.literal(dialect(), i, obj));
+      }
+    }
+    return wherePrimaryKey(mapping, obj);
+  }
+
+  // set only changed fields, the row is found by primary key of 'before'.
+  // Not changed object is an error (use SqlBuilder::updateChanged to skip it)
+  template<class T>
+  SqlUpdate &objectChanges(const SqlRowMapping<T> &mapping, const T &before, const T &after) {
+    if (!mapping.hasPrimaryKey()) {
+      addError("SqlUpdate. Mapping for '" + mapping.tableName() + "' has no primary key");
+      return *this;
+    }
+    std::size_t changed = 0;
+    for (std::size_t i = 0; i < mapping.size(); i++) {
+      if (!mapping.equal(i, before, after)) {
+        set(mapping.name(i), mapping.literal(dialect(), i, after));
+        changed++;
+      }
+    }
+    if (changed == 0) {
+      addError("SqlUpdate. Object for '" + mapping.tableName() + "' has no changed fields");
+      return *this;
+    }
+    return wherePrimaryKey(mapping, before);
+  }
 
   SqlWhere<SqlUpdate> &where();
+  SqlUpdate &returning(const std::vector<std::string> &cols);
+  SqlUpdate &with(const std::string &name, SqlQuery &select);
 
   virtual std::string sql() override;
 
 private:
+  friend class SqlBuilder;
   SqlUpdate &setValue(const std::string &name, const std::string &val);
 
+  template<class T>
+  SqlUpdate &wherePrimaryKey(const SqlRowMapping<T> &mapping, const T &obj) {
+    for (std::size_t i = 0; i < mapping.size(); i++) {
+      if (mapping.isPrimaryKey(i)) {
+        where().equal(mapping.name(i), mapping.literal(dialect(), i, obj));
+      }
+    }
+    return *this;
+  }
+
   std::shared_ptr<SqlWhere<SqlUpdate>> m_where;
   std::vector<std::string> m_columns;
   std::map<std::string, std::string> m_values;
 };
 
+// Many rows updated by key in one statement per chunk, the first value of every row is the key:
+//   UPDATE users SET name = CASE id WHEN 1 THEN 'a' WHEN 2 THEN 'b' END WHERE id IN (1, 2)
+// PostgreSQL:
+//   UPDATE users SET name = v.name FROM (VALUES (1, 'a'), (2, 'b')) AS v(id, name) WHERE users.id = v.id
+// For the same key the last row wins.
+// In PostgreSQL values have types of literals, so NULL or text for not text columns
+// may require SqlLiteral with a cast, like SqlLiteral("NULL::integer")
+class SqlUpdateBatch : public SqlQuery {
+public:
+  SqlUpdateBatch(const std::string &tableName, const std::string &keyColumn, SqlBuilder *builder);
+  const std::string &keyColumn();
+  SqlUpdateBatch &colum(const std::string &col);
+  SqlUpdateBatch &addColums(const std::vector<std::string> &cols);
+
+  SqlUpdateBatch &newRow();
+  template<typename TKey, typename... TVals>
+  SqlUpdateBatch &row(const TKey &key, const TVals &...vals) {
+    newRow();
+    val(key);
+    (val(vals), ...);
+    return newRow();
+  }
+  std::size_t rowsCount();
+
+  // by default limits of the database dialect, maxRows is the size of batch
+  SqlUpdateBatch &setChunkLimits(const SqlChunkLimits &limits);
+  SqlChunkLimits chunkLimits();
+
+  SqlUpdateBatch &val(const std::string &val);
+  SqlUpdateBatch &val(const char *val);
+  SqlUpdateBatch &val(int val);
+  SqlUpdateBatch &val(long val);
+  SqlUpdateBatch &val(float val);
+  SqlUpdateBatch &val(double val);
+  SqlUpdateBatch &val(const SqlLiteral &val);
+
+  virtual std::string sql() override;
+  virtual std::vector<std::string> statements() override;
+
+private:
+  std::vector<const std::vector<std::string> *> allRows();
+  std::size_t rowSize(const std::vector<std::string> &row);
+  std::string renderChunk(const std::vector<const std::vector<std::string> *> &rows, std::size_t begin, std::size_t end);
+
+  std::string m_keyColumn;
+  std::vector<std::string> m_columns;
+  std::vector<std::string> m_values; // current row
+  std::vector<std::vector<std::string>> m_rows;
+  std::map<std::string, std::size_t> m_rowsByKey;
+  std::optional<SqlChunkLimits> m_chunkLimits;
+};
+
 class SqlDelete : public SqlQuery {
 public:
   SqlDelete(const std::string &tableName, SqlBuilder *builder);
   SqlWhere<SqlDelete> &where();
+  SqlDelete &returning(const std::vector<std::string> &cols);
+  SqlDelete &with(const std::string &name, SqlQuery &select);
   virtual std::string sql() override;
 private:
+  friend class SqlBuilder;
   std::shared_ptr<SqlWhere<SqlDelete>> m_where;
 };
 
+// ---------------------------------------------------------------------
+// Queries created by SqlBuilder::selectFrom<TTable>() and others carry the table type,
+// so columns declared by SqlColumnDef are checked at compile time:
+//
+//   builder.selectFrom<Users>().colum<OrdersId>(); // error: column of other table
+//
+// Untyped methods return the base query and the check is done at runtime then
+// (debug builds only). Columns of joined tables can be added by name.
+
+template<class TTable, class TQuery, class TTypedQuery>
+class SqlTypedWhere {
+public:
+  SqlTypedWhere(SqlWhere<TQuery> &where) : m_where(&where) { }
+
+  template <class TColumn, typename TVal>
+  SqlTypedWhere &notEqual(const TVal &value) {
+    static_assert(SqlIsTableColumn<TTable, TColumn>::value, "Column belongs to other table");
+    m_where->template notEqual<TColumn>(value);
+    return *this;
+  }
+
+  template <class TColumn, typename TVal>
+  SqlTypedWhere &equal(const TVal &value) {
+    static_assert(SqlIsTableColumn<TTable, TColumn>::value, "Column belongs to other table");
+    m_where->template equal<TColumn>(value);
+    return *this;
+  }
+
+  template <class TColumn, typename TVal>
+  SqlTypedWhere &moreThen(const TVal &value) {
+    static_assert(SqlIsTableColumn<TTable, TColumn>::value, "Column belongs to other table");
+    m_where->template moreThen<TColumn>(value);
+    return *this;
+  }
+
+  template <class TColumn, typename TVal>
+  SqlTypedWhere &lessThen(const TVal &value) {
+    static_assert(SqlIsTableColumn<TTable, TColumn>::value, "Column belongs to other table");
+    m_where->template lessThen<TColumn>(value);
+    return *this;
+  }
+
+  template <class TColumn>
+  SqlTypedWhere &like(const std::string &value) {
+    static_assert(SqlIsTableColumn<TTable, TColumn>::value, "Column belongs to other table");
+    m_where->template like<TColumn>(value);
+    return *this;
+  }
+
+  template <typename TVal>
+  SqlTypedWhere &notEqual(const std::string &name, TVal value) {
+    m_where->notEqual(name, value);
+    return *this;
+  }
+
+  template <typename TVal>
+  SqlTypedWhere &equal(const std::string &name, TVal value) {
+    m_where->equal(name, value);
+    return *this;
+  }
+
+  template <typename TVal>
+  SqlTypedWhere &moreThen(const std::string &name, TVal value) {
+    m_where->moreThen(name, value);
+    return *this;
+  }
+
+  template <typename TVal>
+  SqlTypedWhere &lessThen(const std::string &name, TVal value) {
+    m_where->lessThen(name, value);
+    return *this;
+  }
+
+  template <typename TVal>
+  SqlTypedWhere &moreOrEqual(const std::string &name, TVal value) {
+    m_where->moreOrEqual(name, value);
+    return *this;
+  }
+
+  template <typename TVal>
+  SqlTypedWhere &lessOrEqual(const std::string &name, TVal value) {
+    m_where->lessOrEqual(name, value);
+    return *this;
+  }
+
+  SqlTypedWhere &like(const std::string &name, const std::string &value) {
+    m_where->like(name, value);
+    return *this;
+  }
+
+  SqlTypedWhere &or_() {
+    m_where->or_();
+    return *this;
+  }
+
+  SqlTypedWhere &and_() {
+    m_where->and_();
+    return *this;
+  }
+
+  SqlTypedWhere subCondition() {
+    return SqlTypedWhere(m_where->subCondition());
+  }
+
+  SqlTypedWhere finishSubCondition() {
+    return SqlTypedWhere(m_where->finishSubCondition());
+  }
+
+  // other conditions (in lists, subqueries and so on)
+  SqlWhere<TQuery> &untyped() {
+    return *m_where;
+  }
+
+  TTypedQuery &endWhere() {
+    // typed queries are created only as TTypedQuery by SqlBuilder
+    return static_cast<TTypedQuery &>(m_where->endWhere());
+  }
+
+private:
+  SqlWhere<TQuery> *m_where;
+};
+
+template<class TTable>
+class SqlTypedSelect : public SqlSelect {
+public:
+  SqlTypedSelect(SqlBuilder *builder) : SqlSelect(TTable::name, builder) { }
+
+  using SqlSelect::colum;
+
+  template<class TColumn>
+  SqlTypedSelect &colum(const std::string &col_as = "") {
+    static_assert(SqlIsTableColumn<TTable, TColumn>::value, "Column belongs to other table");
+    SqlSelect::colum<TColumn>(col_as);
+    return *this;
+  }
+
+  SqlTypedWhere<TTable, SqlSelect, SqlTypedSelect> where() {
+    return SqlTypedWhere<TTable, SqlSelect, SqlTypedSelect>(SqlSelect::where());
+  }
+};
+
+template<class TTable>
+class SqlTypedInsert : public SqlInsert {
+public:
+  SqlTypedInsert(SqlBuilder *builder) : SqlInsert(TTable::name, builder) { }
+
+  using SqlInsert::colum;
+  using SqlInsert::val;
+
+  template<class TColumn>
+  SqlTypedInsert &colum() {
+    static_assert(SqlIsTableColumn<TTable, TColumn>::value, "Column belongs to other table");
+    SqlInsert::colum<TColumn>();
+    return *this;
+  }
+
+  template<class TColumn, typename TVal>
+  SqlTypedInsert &val(const TVal &val) {
+    static_assert(SqlIsTableColumn<TTable, TColumn>::value, "Column belongs to other table");
+    SqlInsert::val<TColumn>(val);
+    return *this;
+  }
+};
+
+template<class TTable>
+class SqlTypedUpdate : public SqlUpdate {
+public:
+  SqlTypedUpdate(SqlBuilder *builder) : SqlUpdate(TTable::name, builder) { }
+
+  using SqlUpdate::set;
+
+  template<class TColumn, typename TVal>
+  SqlTypedUpdate &set(const TVal &val) {
+    static_assert(SqlIsTableColumn<TTable, TColumn>::value, "Column belongs to other table");
+    SqlUpdate::set<TColumn>(val);
+    return *this;
+  }
+
+  SqlTypedWhere<TTable, SqlUpdate, SqlTypedUpdate> where() {
+    return SqlTypedWhere<TTable, SqlUpdate, SqlTypedUpdate>(SqlUpdate::where());
+  }
+};
+
+template<class TTable>
+class SqlTypedDelete : public SqlDelete {
+public:
+  SqlTypedDelete(SqlBuilder *builder) : SqlDelete(TTable::name, builder) { }
+
+  SqlTypedWhere<TTable, SqlDelete, SqlTypedDelete> where() {
+    return SqlTypedWhere<TTable, SqlDelete, SqlTypedDelete>(SqlDelete::where());
+  }
+};
+
+class ISqlCopySink {
+public:
+  virtual ~ISqlCopySink() { }
+  virtual void write(const char *data, std::size_t size) = 0;
+};
+
+class SqlCopyStringSink : public ISqlCopySink {
+public:
+  virtual void write(const char *data, std::size_t size) override;
+  const std::string &data() const;
+
+private:
+  std::string m_data;
+};
+
+// PostgreSQL COPY table(cols) FROM STDIN: sql() is the statement and values are encoded
+// to the payload (for PQputCopyData). Payload is kept in memory until a sink is set,
+// after that it is written to the sink every time when bufferSize is reached.
+// For BINARY format values must have the same types as the table columns (int - int4, long - int8,
+// float - float4, double - float8, string - text)
+class SqlCopy : public SqlQuery {
+public:
+  SqlCopy(const std::string &tableName, SqlBuilder *builder);
+  SqlCopy &colum(const std::string &col);
+  SqlCopy &addColums(const std::vector<std::string> &cols);
+  SqlCopy &setFormat(SqlCopyFormat format);
+  SqlCopyFormat format();
+  SqlCopy &setSink(ISqlCopySink *sink, std::size_t bufferSize = 65536);
+
+  SqlCopy &val(const std::string &val);
+  SqlCopy &val(const char *val);
+  SqlCopy &val(int val);
+  SqlCopy &val(long val);
+  SqlCopy &val(float val);
+  SqlCopy &val(double val);
+  SqlCopy &valNull();
+
+  template<typename... TVals>
+  SqlCopy &row(const TVals &...vals) {
+    if (m_rowValues != 0) {
+      addError("SqlCopy. Previous row for '" + tableName() + "' is not finished");
+      return *this;
+    }
+    (val(vals), ...);
+    if (m_rowValues != 0) {
+      addError("SqlCopy. Expected " + std::to_string(m_columns.size()) + " values in row for '" + tableName() + "'");
+    }
+    return *this;
+  }
+  std::size_t rowsCount();
+
+  // adds trailer and writes the rest of payload to the sink, next values are not allowed
+  SqlCopy &finish();
+  // all payload after finish(), if sink was not set
+  const std::string &payload();
+
+  virtual std::string sql() override;
+
+private:
+  void start();
+  bool beginValue();
+  void endValue();
+  void flush();
+  void writeText(const std::string &val);
+  void writeInt16(int16_t val);
+  void writeInt32(int32_t val);
+  void writeInt64(int64_t val);
+
+  std::vector<std::string> m_columns;
+  SqlCopyFormat m_format;
+  ISqlCopySink *m_sink;
+  std::size_t m_bufferSize;
+  std::string m_buffer;
+  std::size_t m_rowValues; // values in current row
+  std::size_t m_rowsCount;
+  bool m_started;
+  bool m_finished;
+};
+
+class SqlUpdateDeltaStats {
+public:
+  std::size_t statements = 0;         // added update statements
+  std::size_t statementsSkipped = 0;  // nothing was changed
+  std::size_t columnsSkipped = 0;     // not changed columns, which were not added to SET
+  std::size_t bytesSaved = 0;         // compared with update of all columns
+};
+
 class SqlBuilder : public ISqlBuilder {
 public:
   SqlBuilder(SqlBuilderForDatabase dbType = SqlBuilderForDatabase::SQLITE3);
-  
-  // TODO begin / end transaction can be added here
+
+  // statements are wrapped into BEGIN / COMMIT, a new transaction is started by limits
+  void setTransaction(bool enabled, const SqlTransactionLimits &limits = SqlTransactionLimits());
+  bool isTransaction() const;
 
   SqlSelect &selectFrom(const std::string &tableName);
   SqlInsert &insertInto(const std::string &tableName);
   SqlInsert &findInsertOrCreate(const std::string &tableName);
   SqlUpdate &update(const std::string &tableName);
   SqlUpdate &findUpdateOrCreate(const std::string &tableName);
+  SqlUpdateBatch &updateBatch(const std::string &tableName, const std::string &keyColumn);
   SqlDelete &deleteFrom(const std::string &sSqlTable);
+  // select for subqueries and CTEs, it is not a statement of the builder
+  SqlSelect &subSelect(const std::string &tableName);
   SqlDelete &findDeleteOrCreate(const std::string &tableName);
+  // only for PostgreSQL
+  SqlCopy &copyInto(const std::string &tableName);
+
+  // one multi-row insert, it is split to statements by chunk limits
+  template<class T, class TRange>
+  SqlInsert &insertObjects(const SqlRowMapping<T> &mapping, const TRange &objects) {
+    return insertInto(mapping.tableName()).objects(mapping, objects);
+  }
+
+  template<class T, class TRange>
+  void updateObjects(const SqlRowMapping<T> &mapping, const TRange &objects) {
+    for (const T &obj : objects) {
+      update(mapping.tableName()).object(mapping, obj);
+    }
+  }
+
+  // returns false and adds nothing if no fields were changed
+  template<class T>
+  bool updateChanged(const SqlRowMapping<T> &mapping, const T &before, const T &after) {
+    if (!mapping.hasPrimaryKey()) {
+      addError("SqlBuilder. Mapping for '" + mapping.tableName() + "' has no primary key");
+      return false;
+    }
+    std::size_t fullSize = 0;
+    std::size_t deltaSize = 0;
+    std::size_t whereSize = 0;
+    std::size_t skipped = 0;
+    for (std::size_t i = 0; i < mapping.size(); i++) {
+      bool changed = !mapping.equal(i, before, after);
+      if (mapping.isPrimaryKey(i)) {
+        // "name = value AND "
+        whereSize += mapping.name(i).size() + 3 + mapping.literal(dialect(), i, before).sql().size() + 5;
+      }
+      if (!changed && mapping.isPrimaryKey(i)) {
+        continue;
+      }
+      // "name = value, "
+      std::size_t setSize = mapping.name(i).size() + 3 + mapping.literal(dialect(), i, after).sql().size() + 2;
+      if (!mapping.isPrimaryKey(i)) {
+        fullSize += setSize;
+      }
+      if (changed) {
+        deltaSize += setSize;
+      } else {
+        skipped++;
+      }
+    }
+    m_updateDeltaStats.columnsSkipped += skipped;
+    if (deltaSize == 0) {
+      // "UPDATE table SET ... WHERE ..."
+      m_updateDeltaStats.statementsSkipped++;
+      m_updateDeltaStats.bytesSaved += 7 + mapping.tableName().size() + 5 + fullSize - 2 + 7 + whereSize - 5;
+      return false;
+    }
+    update(mapping.tableName()).objectChanges(mapping, before, after);
+    m_updateDeltaStats.statements++;
+    if (fullSize > deltaSize) {
+      m_updateDeltaStats.bytesSaved += fullSize - deltaSize;
+    }
+    return true;
+  }
+
+  const SqlUpdateDeltaStats &updateDeltaStats() const;
+  void resetUpdateDeltaStats();
+
+  // Optional pass before rendering, only neighbour queries are merged:
+  //  - inserts into the same table and columns - to one multi-row insert (not with doUpdateSet(),
+  //    PostgreSQL can not update the same row twice in one statement)
+  //  - deletes from the same table by 'key = X' - to one delete with 'key IN (...)'
+  //  - updates of the same table with the same where - to one update, the last value of a column wins,
+  //    if where does not use updated columns. Values as expressions (like SqlLiteral("level + 1"))
+  //    are not detected, so do not coalesce such updates.
+  // Returns count of removed queries, references to them must not be used after that.
+  std::size_t coalesce();
+
+  // Optional pass before rendering, conditions of where (and having) are simplified:
+  //  - sub conditions with one term or only AND are merged to the parent, empty are removed
+  //  - duplicate terms and OR groups are removed
+  //  - 'x = 1 OR x = 2' is rewritten to 'x IN (1, 2)'
+  //  - always false conditions ('x = 1 AND x = 2'): updates and deletes are skipped,
+  //    selects get 'WHERE 1 = 0'
+  SqlSimplifyReport simplify();
+
+  // Optional pass before rendering, conditions are rewritten to forms which can use indexes:
+  //  - col LIKE 'abc%' -> col >= 'abc' AND col < 'abd' (not for MySQL, it does it itself).
+  //    Range is compared by collation of the column, so it is the same as LIKE only for
+  //    case sensitive comparison (SQLite: BINARY and PRAGMA case_sensitive_like = ON,
+  //    PostgreSQL: "C" collation). That is why the pass is opt-in.
+  //  - column to the left side: 10 < age -> age > 10
+  SqlRewriteReport rewriteSargable();
+
+  // full scan is expected for select, update and delete without where
+  void registerLargeTable(const std::string &tableName);
+  // Checks of built queries for known performance problems: SELECT *, no where on large tables,
+  // LIKE with leading '%', OR across different columns, wide OR chains of equals,
+  // IN lists which change statement text by count of values.
+  // Conditions of HAVING and joins, the select of INSERT ... SELECT and subqueries from subSelect()
+  // (conditions and CTE) are checked too.
+  // Only in debug builds (empty in release). Warnings are only returned, hasErrors() is not changed by them.
+  std::vector<std::string> lint(const SqlLintOptions &options = SqlLintOptions());
+
+  template<class TTable>
+  SqlTypedSelect<TTable> &selectFrom() {
+    static_assert(std::is_base_of<SqlTableDef, TTable>::value, "Expected table declared by SqlTableDef");
+    return addTyped<SqlTypedSelect<TTable>>();
+  }
+
+  template<class TTable>
+  SqlTypedInsert<TTable> &insertInto() {
+    static_assert(std::is_base_of<SqlTableDef, TTable>::value, "Expected table declared by SqlTableDef");
+    return addTyped<SqlTypedInsert<TTable>>();
+  }
+
+  template<class TTable>
+  SqlTypedUpdate<TTable> &update() {
+    static_assert(std::is_base_of<SqlTableDef, TTable>::value, "Expected table declared by SqlTableDef");
+    return addTyped<SqlTypedUpdate<TTable>>();
+  }
+
+  template<class TTable>
+  SqlTypedDelete<TTable> &deleteFrom() {
+    static_assert(std::is_base_of<SqlTableDef, TTable>::value, "Expected table declared by SqlTableDef");
+    return addTyped<SqlTypedDelete<TTable>>();
+  }
 
   void clear();
 
   virtual bool hasErrors() override;
   virtual std::string sql() override;
+  std::vector<std::string> statements();
+  // every statement is terminated by ';', for example for sqlite3_exec
+  std::string script();
 
+  // values are formatted when they are added, so set it before building queries
   virtual void setDatabaseType(SqlBuilderForDatabase dbType) override;
   virtual SqlBuilderForDatabase databaseType() override;
+  const ISqlDialect &dialect() const;
 
 protected:
   friend SqlSelect;
   friend SqlInsert;
   friend SqlUpdate;
+  friend SqlQuery;
   friend SqlWhere<SqlSelect>;
   virtual void addError(const std::string &err) override;
 
+protected:
+  // rendered by the dialect, it must live longer than builder
+  SqlBuilder(const ISqlDialect &dialect);
+
 private:
   std::vector<std::string> m_errors;
   std::vector<std::shared_ptr<SqlQuery>> m_queries;
-  SqlBuilderForDatabase m_dbType;
+  bool canCoalesce(const std::shared_ptr<SqlQuery> &first, const std::shared_ptr<SqlQuery> &next);
+  std::shared_ptr<SqlQuery> coalesceRun(std::size_t begin, std::size_t end);
+  static bool deleteByKey(SqlDelete *query, std::string &key, std::string &value);
+  template<class TQuery>
+  TQuery &addTyped() {
+    m_queries.push_back(std::make_shared<TQuery>(this));
+    return *(TQuery *)(m_queries[m_queries.size() -1].get());
+  }
+  bool isLargeTable(const std::string &tableName);
+  void lintSelect(SqlSelect &select, bool subquery, const SqlLintOptions &options, std::vector<std::string> &warnings);
+  template<class T>
+  void lintWhere(SqlWhere<T> &where, const std::string &table, const SqlLintOptions &options, std::vector<std::string> &warnings);
+
+  std::vector<std::shared_ptr<SqlQuery>> m_coalescedQueries; // keep references alive
+  std::vector<std::shared_ptr<SqlQuery>> m_subqueries;
+  std::vector<std::string> m_largeTables;
+  const ISqlDialect *m_dialect;
+  SqlUpdateDeltaStats m_updateDeltaStats;
+  bool m_transaction;
+  SqlTransactionLimits m_transactionLimits;
+};
+
+template<class TDialect>
+class BasicSqlBuilder : public SqlBuilder {
+public:
+  BasicSqlBuilder() : SqlBuilder(SqlDialect<TDialect>::instance()) { }
+
+private:
+  // dialect is defined by TDialect only
+  virtual void setDatabaseType(SqlBuilderForDatabase dbType) override {
+    if (dbType != TDialect::databaseType) {
+      addError("BasicSqlBuilder. Database type can not be changed, it is defined by dialect policy");
+    }
+  }
+};
+
+// ---------------------------------------------------------------------
+// Generates C++ functions with typed parameters from a spec of named queries:
+//
+//   -- name: findUserByPass
+//   -- param: pass string
+//   SELECT id, name FROM users WHERE pass = ?;
+//
+// Supported param types: string, int, long, float, double
+
+class SqlCodeGeneratorParam {
+public:
+  SqlCodeGeneratorParam(const std::string &name, const std::string &type);
+  const std::string &name() const;
+  const std::string &type() const;
+  std::string cppType() const;
+
+private:
+  std::string m_name;
+  std::string m_type;
+};
+
+class SqlCodeGeneratorQuery {
+public:
+  SqlCodeGeneratorQuery(const std::string &name);
+  const std::string &name() const;
+  const std::string &sql() const;
+  const std::vector<SqlCodeGeneratorParam> &params() const;
+  const std::vector<std::size_t> &slots() const;
+
+private:
+  friend class SqlCodeGenerator;
+  std::string m_name;
+  std::string m_sql;
+  std::vector<SqlCodeGeneratorParam> m_params;
+  std::vector<std::size_t> m_slots;
+};
+
+class SqlCodeGenerator {
+public:
+  SqlCodeGenerator();
+  bool parseSpec(const std::string &spec);
+  bool hasErrors() const;
+  const std::vector<std::string> &errors() const;
+  const std::vector<SqlCodeGeneratorQuery> &queries() const;
+  std::string generateHeader(const std::string &namespaceName, const std::string &specName = "") const;
+  // valid C++ identifier and not a keyword
+  static bool isIdentifier(const std::string &name);
+
+private:
+  void finishQuery(SqlCodeGeneratorQuery &query, int lineNumber);
+  static bool hasName(const std::vector<SqlCodeGeneratorQuery> &queries, const std::string &name);
+  static bool hasParam(const SqlCodeGeneratorQuery &query, const std::string &name);
+  static std::string cppStringLiteral(const std::string &value);
+
+  std::vector<std::string> m_errors;
+  std::vector<SqlCodeGeneratorQuery> m_queries;
+};
+
+// ---------------------------------------------------------------------
+// Compile-time SQL for queries with fixed tables, columns and operators.
+// Values are left as '?' placeholders, declare result as constexpr:
+//   constexpr auto q = SqlStatic::selectFrom("users").colum("id").where().equal("pass").sql();
+// Text with '$1' placeholders for PostgreSQL: q.sql<SqlDialectPostgreSQL>()
+
+template<std::size_t N>
+class SqlStaticString {
+public:
+  constexpr SqlStaticString() : m_data{} { }
+
+  constexpr SqlStaticString(const char (&str)[N + 1]) : m_data{} {
+    for (std::size_t i = 0; i < N; i++) {
+      m_data[i] = str[i];
+    }
+  }
+
+  constexpr std::size_t size() const { return N; }
+  constexpr char operator[](std::size_t i) const { return m_data[i]; }
+  constexpr char &operator[](std::size_t i) { return m_data[i]; }
+  constexpr const std::array<char, N + 1> &array() const { return m_data; }
+  const char *c_str() const { return m_data.data(); }
+  std::string str() const { return std::string(m_data.data(), N); }
+
+  template<std::size_t M>
+  constexpr SqlStaticString<N + M> operator+(const SqlStaticString<M> &other) const {
+    SqlStaticString<N + M> ret;
+    for (std::size_t i = 0; i < N; i++) {
+      ret[i] = m_data[i];
+    }
+    for (std::size_t i = 0; i < M; i++) {
+      ret[N + i] = other[i];
+    }
+    return ret;
+  }
+
+  template<std::size_t M>
+  constexpr SqlStaticString<N + M - 1> operator+(const char (&str)[M]) const {
+    return *this + SqlStaticString<M - 1>(str);
+  }
+
+private:
+  std::array<char, N + 1> m_data;
+};
+
+template<std::size_t N>
+SqlStaticString(const char (&str)[N]) -> SqlStaticString<N - 1>;
+
+template<std::size_t N, std::size_t K>
+class SqlStaticStatement {
+public:
+  constexpr SqlStaticStatement(const SqlStaticString<N> &text) : m_text(text), m_slots{} {
+    std::size_t slot = 0;
+    for (std::size_t i = 0; i < N; i++) {
+      if (text[i] == '?') {
+        if (slot >= K) {
+          throw std::logic_error("SqlStaticStatement. Too many placeholders");
+        }
+        m_slots[slot] = i;
+        slot++;
+      }
+    }
+    if (slot != K) {
+      throw std::logic_error("SqlStaticStatement. Too few placeholders");
+    }
+  }
+
+  static constexpr std::size_t placeholders() { return K; }
+  constexpr std::size_t size() const { return N; }
+  constexpr const std::array<char, N + 1> &text() const { return m_text.array(); }
+  constexpr std::size_t slot(std::size_t i) const { return m_slots[i]; }
+  const char *c_str() const { return m_text.c_str(); }
+  std::string str() const { return m_text.str(); }
+
+  // text with placeholders of the dialect for prepared statements (TDialect::placeholder):
+  // '?' for SQLite and MySQL, '$1', '$2', ... for PostgreSQL
+  template<class TDialect>
+  constexpr auto sql() const {
+    SqlStaticString<N - K + placeholdersSize<TDialect>()> ret;
+    std::size_t pos = 0;
+    std::size_t slot = 0;
+    for (std::size_t i = 0; i < N; i++) {
+      if (m_text[i] != '?') {
+        ret[pos++] = m_text[i];
+        continue;
+      }
+      slot++;
+      pos += TDialect::placeholder(slot, &ret[pos]);
+    }
+    return ret;
+  }
+
+  // put formatted literals instead of placeholders
+  template<class TDialect = SqlDialectSqlite3, typename... TVals>
+  std::string render(const TVals &...values) const {
+    static_assert(sizeof...(TVals) == K, "Count of values must be equal to count of placeholders");
+    std::string ret;
+    ret.reserve(N - K + (SqlBuilderHelpers::maxValueSize(values) + ... + 0));
+    std::size_t pos = 0;
+    std::size_t slot = 0;
+    // text before the placeholder and the value, left to right
+    [[maybe_unused]] auto append = [&](const auto &value) {
+      ret.append(c_str() + pos, m_slots[slot] - pos);
+      SqlBuilderHelpers::appendValue<TDialect>(ret, value);
+      pos = m_slots[slot] + 1;
+      slot++;
+    };
+    (append(values), ...);
+    ret.append(c_str() + pos, N - pos);
+    return ret;
+  }
+
+private:
+  template<class TDialect>
+  static constexpr std::size_t placeholdersSize() {
+    std::size_t ret = 0;
+    for (std::size_t i = 1; i <= K; i++) {
+      ret += TDialect::placeholder(i, nullptr);
+    }
+    return ret;
+  }
+
+  SqlStaticString<N> m_text;
+  std::array<std::size_t, K> m_slots;
+};
+
+template<
+  SqlQueryType TType,
+  std::size_t NTable,
+  std::size_t NColumns,
+  std::size_t NWhere,
+  std::size_t NSlots,
+  std::size_t NDepth,
+  bool TLastCondition
+>
+class SqlStaticQuery {
+public:
+  constexpr SqlStaticQuery(
+    const SqlStaticString<NTable> &table,
+    const SqlStaticString<NColumns> &columns,
+    const SqlStaticString<NWhere> &where
+  ) : m_table(table), m_columns(columns), m_where(where) { }
+
+  template<std::size_t M>
+  constexpr auto colum(const char (&col)[M]) const {
+    static_assert(TType == SqlQueryType::SELECT || TType == SqlQueryType::INSERT, "colum() allowed only for select and insert");
+    static_assert(NWhere == 0, "colum() must be called before conditions");
+    if (!SqlBuilderHelpers::isIdentifier(col)) {
+      throw std::invalid_argument("SqlStaticQuery. Invalid column name");
+    }
+    constexpr std::size_t slots = NSlots + (TType == SqlQueryType::INSERT ? 1 : 0);
+    if constexpr (NColumns == 0) {
+      return withColumns<slots>(SqlStaticString<M - 1>(col));
+    } else {
+      return withColumns<slots>(m_columns + ", " + col);
+    }
+  }
+
+  template<std::size_t M, std::size_t A>
+  constexpr auto colum(const char (&col)[M], const char (&col_as)[A]) const {
+    static_assert(TType == SqlQueryType::SELECT, "colum() with AS allowed only for select");
+    if (!SqlBuilderHelpers::isIdentifier(col_as)) {
+      throw std::invalid_argument("SqlStaticQuery. Invalid column alias");
+    }
+    auto ret = colum(col);
+    return ret.template withColumns<NSlots>(ret.m_columns + " AS " + col_as);
+  }
+
+  template<std::size_t M>
+  constexpr auto set(const char (&name)[M]) const {
+    static_assert(TType == SqlQueryType::UPDATE, "set() allowed only for update");
+    static_assert(NWhere == 0, "set() must be called before conditions");
+    if (!SqlBuilderHelpers::isIdentifier(name)) {
+      throw std::invalid_argument("SqlStaticQuery. Invalid column name");
+    }
+    if constexpr (NColumns == 0) {
+      return withColumns<NSlots + 1>(SqlStaticString<M - 1>(name) + " = ?");
+    } else {
+      return withColumns<NSlots + 1>(m_columns + ", " + name + " = ?");
+    }
+  }
+
+  // only for readability, the same as in SqlBuilder
+  constexpr const SqlStaticQuery &where() const {
+    static_assert(TType != SqlQueryType::INSERT, "where() not allowed for insert");
+    return *this;
+  }
+
+  template<std::size_t M>
+  constexpr auto notEqual(const char (&name)[M]) const { return cond(name, " <> ?"); }
+
+  template<std::size_t M>
+  constexpr auto equal(const char (&name)[M]) const { return cond(name, " = ?"); }
+
+  template<std::size_t M>
+  constexpr auto moreThen(const char (&name)[M]) const { return cond(name, " > ?"); }
+
+  template<std::size_t M>
+  constexpr auto lessThen(const char (&name)[M]) const { return cond(name, " < ?"); }
+
+  template<std::size_t M>
+  constexpr auto like(const char (&name)[M]) const { return cond(name, " LIKE ?"); }
+
+  constexpr auto or_() const {
+    static_assert(TLastCondition, "or_() must follow a condition");
+    return withWhere<NSlots, NDepth, false>(m_where + " OR ");
+  }
+
+  constexpr auto and_() const {
+    static_assert(TLastCondition, "and_() must follow a condition");
+    return withWhere<NSlots, NDepth, false>(m_where + " AND ");
+  }
+
+  constexpr auto subCondition() const {
+    static_assert(TType != SqlQueryType::INSERT, "conditions not allowed for insert");
+    if constexpr (TLastCondition) {
+      return withWhere<NSlots, NDepth + 1, false>(m_where + " AND (");
+    } else {
+      return withWhere<NSlots, NDepth + 1, false>(m_where + "(");
+    }
+  }
+
+  constexpr auto finishSubCondition() const {
+    static_assert(NDepth > 0, "finishSubCondition() without subCondition()");
+    static_assert(TLastCondition, "sub condition can not be empty or finished by logical operator");
+    return withWhere<NSlots, NDepth - 1, true>(m_where + ")");
+  }
+
+  constexpr auto sql() const {
+    static_assert(NDepth == 0, "not all sub conditions are finished");
+    static_assert(NWhere == 0 || TLastCondition, "conditions can not be finished by logical operator");
+    if constexpr (TType == SqlQueryType::SELECT) {
+      if constexpr (NColumns == 0) {
+        return statement(SqlStaticString("SELECT * FROM ") + m_table + whereClause());
+      } else {
+        return statement(SqlStaticString("SELECT ") + m_columns + " FROM " + m_table + whereClause());
+      }
+    } else if constexpr (TType == SqlQueryType::INSERT) {
+      static_assert(NColumns > 0, "insert requires at least one column");
+      return statement(SqlStaticString("INSERT INTO ") + m_table + "(" + m_columns + ") VALUES(" + placeholders() + ")");
+    } else if constexpr (TType == SqlQueryType::UPDATE) {
+      static_assert(NColumns > 0, "update requires at least one set()");
+      return statement(SqlStaticString("UPDATE ") + m_table + " SET " + m_columns + whereClause());
+    } else {
+      return statement(SqlStaticString("DELETE FROM ") + m_table + whereClause());
+    }
+  }
+
+private:
+  template<SqlQueryType, std::size_t, std::size_t, std::size_t, std::size_t, std::size_t, bool>
+  friend class SqlStaticQuery;
+
+  template<std::size_t NSlotsNew, std::size_t NColumnsNew>
+  constexpr auto withColumns(const SqlStaticString<NColumnsNew> &columns) const {
+    return SqlStaticQuery<TType, NTable, NColumnsNew, NWhere, NSlotsNew, NDepth, TLastCondition>(
+      m_table, columns, m_where
+    );
+  }
+
+  template<std::size_t NSlotsNew, std::size_t NDepthNew, bool TLastConditionNew, std::size_t NWhereNew>
+  constexpr auto withWhere(const SqlStaticString<NWhereNew> &where) const {
+    return SqlStaticQuery<TType, NTable, NColumns, NWhereNew, NSlotsNew, NDepthNew, TLastConditionNew>(
+      m_table, m_columns, where
+    );
+  }
+
+  template<std::size_t M, std::size_t O>
+  constexpr auto cond(const char (&name)[M], const char (&op)[O]) const {
+    static_assert(TType != SqlQueryType::INSERT, "conditions not allowed for insert");
+    if (!SqlBuilderHelpers::isIdentifier(name)) {
+      throw std::invalid_argument("SqlStaticQuery. Invalid column name in condition");
+    }
+    if constexpr (TLastCondition) {
+      return withWhere<NSlots + 1, NDepth, true>(m_where + " AND " + name + op);
+    } else {
+      return withWhere<NSlots + 1, NDepth, true>(m_where + name + op);
+    }
+  }
+
+  constexpr auto whereClause() const {
+    if constexpr (NWhere == 0) {
+      return SqlStaticString<0>();
+    } else {
+      return SqlStaticString(" WHERE ") + m_where;
+    }
+  }
+
+  static constexpr auto placeholders() {
+    SqlStaticString<NSlots * 3 - 2> ret;
+    for (std::size_t i = 0; i < NSlots; i++) {
+      if (i > 0) {
+        ret[i * 3 - 2] = ',';
+        ret[i * 3 - 1] = ' ';
+      }
+      ret[i * 3] = '?';
+    }
+    return ret;
+  }
+
+  template<std::size_t N>
+  static constexpr SqlStaticStatement<N, NSlots> statement(const SqlStaticString<N> &text) {
+    return SqlStaticStatement<N, NSlots>(text);
+  }
+
+  SqlStaticString<NTable> m_table;
+  SqlStaticString<NColumns> m_columns;
+  SqlStaticString<NWhere> m_where;
+};
+
+class SqlStatic {
+public:
+  template<std::size_t N>
+  static constexpr auto selectFrom(const char (&tableName)[N]) {
+    return SqlStaticQuery<SqlQueryType::SELECT, N - 1, 0, 0, 0, 0, false>(table(tableName), {}, {});
+  }
+
+  template<std::size_t N>
+  static constexpr auto insertInto(const char (&tableName)[N]) {
+    return SqlStaticQuery<SqlQueryType::INSERT, N - 1, 0, 0, 0, 0, false>(table(tableName), {}, {});
+  }
+
+  template<std::size_t N>
+  static constexpr auto update(const char (&tableName)[N]) {
+    return SqlStaticQuery<SqlQueryType::UPDATE, N - 1, 0, 0, 0, 0, false>(table(tableName), {}, {});
+  }
+
+  template<std::size_t N>
+  static constexpr auto deleteFrom(const char (&tableName)[N]) {
+    return SqlStaticQuery<SqlQueryType::DELETE, N - 1, 0, 0, 0, 0, false>(table(tableName), {}, {});
+  }
+
+private:
+  template<std::size_t N>
+  static constexpr SqlStaticString<N - 1> table(const char (&tableName)[N]) {
+    if (!SqlBuilderHelpers::isIdentifier(tableName)) {
+      throw std::invalid_argument("SqlStatic. Invalid table name");
+    }
+    return SqlStaticString<N - 1>(tableName);
+  }
 };
 
-} // namespace wsjcpp
\ No newline at end of file
+} // namespace wsjcpp